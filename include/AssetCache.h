@@ -0,0 +1,159 @@
+/**
+ * @file AssetCache.h
+ * @brief Helpers for the on-disk cache of preprocessed assets
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Static helpers to locate and key cached asset files
+ *
+ * Cached files live in `<root>/<category>/`. The root defaults to `cache`
+ * in the working directory; Game::Init points it inside the asset root
+ * (see FileSystem). Cache keys are 64-bit FNV-1a hashes of everything the
+ * cached data depends on, so a stale file is simply never looked up again.
+ * Files are replaced with WriteAtomic, never rewritten in place, because
+ * other processes (host and client share the cache) may have them mapped.
+ *
+ * All methods are static, no instantiation is required.
+ */
+class AssetCache {
+public:
+  /// FNV-1a 64-bit offset basis (initial hash value)
+  static const uint64_t HASH_SEED = 14695981039346656037ull;
+
+  /**
+   * @brief Continues an FNV-1a hash over a block of bytes
+   * @param data Bytes to hash
+   * @param size Number of bytes
+   * @param hash Previous hash value (HASH_SEED to start)
+   * @return Updated hash
+   */
+  static uint64_t Hash(const void *data, size_t size,
+                       uint64_t hash = HASH_SEED) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  /// Continues a hash over a string
+  static uint64_t Hash(const std::string &text, uint64_t hash = HASH_SEED) {
+    return Hash(text.data(), text.size(), hash);
+  }
+
+  /**
+   * @brief Hashes the identity of a file (path, size and modification time)
+   *
+   * Much cheaper than hashing the contents; used where the source files are
+   * large and only change when replaced.
+   *
+   * @param path File to identify
+   * @param hash Previous hash value
+   * @return Updated hash (unchanged apart from the path if the file is missing)
+   */
+  static uint64_t HashFileStamp(const std::string &path,
+                                uint64_t hash = HASH_SEED) {
+    hash = Hash(path, hash);
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (!ec)
+      hash = Hash(&size, sizeof(size), hash);
+    auto stamp = std::filesystem::last_write_time(path, ec);
+    if (!ec) {
+      auto ticks = stamp.time_since_epoch().count();
+      hash = Hash(&ticks, sizeof(ticks), hash);
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Directory that holds every cache category
+   *
+   * Assign to it before any cache is used to move the cache elsewhere.
+   */
+  static std::string &Root() {
+    static std::string root = "cache";
+    return root;
+  }
+
+  /**
+   * @brief Builds the path of a cache file, creating its directory
+   * @param category Sub-directory (e.g. "fonts")
+   * @param key Cache key
+   * @param extension File extension including the dot
+   * @return Full path of the cache file
+   */
+  static std::string PathFor(const std::string &category, uint64_t key,
+                             const std::string &extension) {
+    std::string dir = Root() + "/" + category;
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    return dir + "/" + name + extension;
+  }
+
+  /**
+   * @brief Writes a cache file through a temporary file and a rename
+   *
+   * The contents go to `<path>.<pid>.tmp`, which replaces `path` only once
+   * it is complete. Readers never see a partial file, and a process that
+   * maps the old file keeps the old contents instead of faulting on a
+   * truncated mapping.
+   *
+   * @param path Cache file
+   * @param write Writes the contents to the stream it is given
+   * @return false if writing or renaming failed (path is left untouched)
+   */
+  static bool WriteAtomic(const std::string &path,
+                          const std::function<void(std::ostream &)> &write) {
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+    std::string temporary = path + "." + std::to_string(pid) + ".tmp";
+    std::error_code ec;
+    {
+      std::ofstream file(temporary, std::ios::binary);
+      if (file) {
+        write(file);
+        file.flush();
+      }
+      if (!file) {
+        file.close();
+        std::filesystem::remove(temporary, ec);
+        return false;
+      }
+    }
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+      std::filesystem::remove(temporary, ec);
+      return false;
+    }
+    return true;
+  }
+};
+
+#endif // ASSET_CACHE_H
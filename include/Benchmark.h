@@ -0,0 +1,86 @@
+/**
+ * @file Benchmark.h
+ * @brief Declaration of the Benchmark class - headless offscreen rendering
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+class Game;
+struct LaunchOptions;
+
+/**
+ * @brief Renders a fixed number of frames into an offscreen framebuffer and
+ * reports frame-time statistics
+ *
+ * Used by `--headless`: the window is created invisible (optionally with an
+ * EGL context, which works with Mesa's llvmpipe on machines without a GPU)
+ * and nothing is presented. Each frame advances the simulation by a fixed
+ * 1/60 s with a slow scripted camera turn, so runs are comparable, then
+ * renders into an FBO and waits for the GPU (glFinish) so the measured time
+ * covers the whole frame. Frames can be dumped as PPM images.
+ *
+ * With `--replay` the recorded input replaces the scripted turn and every
+ * frame until the end of the log is measured. Since ticks are fixed and
+ * each frame advances exactly 1/60 s, the same log renders the same frames
+ * on every run.
+ */
+class Benchmark {
+public:
+  /// Frames rendered before measuring (shader warm-up, texture uploads)
+  static const int WARMUP_FRAMES = 30;
+
+  /**
+   * @brief Creates the offscreen framebuffer
+   * @param width Framebuffer width in pixels
+   * @param height Framebuffer height in pixels
+   */
+  Benchmark(unsigned int width, unsigned int height);
+  ~Benchmark();
+
+  Benchmark(const Benchmark &) = delete;
+  Benchmark &operator=(const Benchmark &) = delete;
+
+  /**
+   * @brief Runs the benchmark described by the launch options
+   * @param game Initialized game (simulation must not be threaded)
+   * @param options Frame count and dump settings
+   * @return Process exit code (0 on success)
+   */
+  static int Run(Game &game, const LaunchOptions &options);
+
+  /// True if the framebuffer is complete
+  bool IsValid() const { return valid; }
+
+  /// Binds the framebuffer and sets the viewport
+  void Bind() const;
+
+  /**
+   * @brief Writes the current framebuffer contents to a binary PPM file
+   * @param path Output file
+   * @return false if the file could not be written
+   */
+  bool DumpFrame(const std::string &path) const;
+
+  /**
+   * @brief Prints min/avg/percentiles/max of a list of frame times
+   * @param label Name of the measured quantity
+   * @param milliseconds Frame times in milliseconds
+   */
+  static void PrintStatistics(const std::string &label,
+                              std::vector<double> milliseconds);
+
+private:
+  unsigned int width, height;
+  unsigned int framebuffer;
+  unsigned int colorBuffer;
+  unsigned int depthBuffer;
+  bool valid;
+};
+
+#endif // BENCHMARK_H
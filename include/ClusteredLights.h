@@ -0,0 +1,122 @@
+/**
+ * @file ClusteredLights.h
+ * @brief Declaration of the ClusteredLights class - clustered point lights
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef CLUSTERED_LIGHTS_H
+#define CLUSTERED_LIGHTS_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+class Shader;
+
+/**
+ * @brief Shades many point lights at a cost that follows local light count
+ *
+ * The view frustum is split into a grid of clusters (screen tiles times
+ * exponential depth slices). Every frame the lights are binned on the CPU:
+ * each light is added to the list of every cluster its sphere overlaps.
+ * The lights, the per-cluster (offset, count) ranges and the light index
+ * lists are uploaded to texture buffers, and a fragment only loops over
+ * the lights of its own cluster.
+ *
+ * Lighting is an additive pass on top of the regular scene: between Begin
+ * and End the caller redraws the lit geometry with the returned shader,
+ * which blends the point-light contribution over the existing image (depth
+ * test LEQUAL, no depth writes; its invariant position matches the scene
+ * shaders' depths exactly). The shader reads the same uniforms as the
+ * textured scene shader (model, objectColor, texture_diffuse1), so
+ * Maze::Submit and Mesh::Draw work unchanged. Only textured geometry is
+ * lit this way.
+ *
+ * Light positions are kept as separate arrays (structure of arrays) so the
+ * per-frame view transform is a plain loop the compiler can vectorize.
+ */
+class ClusteredLights {
+public:
+  /// Screen tiles across and down
+  static const int TILES_X = 16;
+  static const int TILES_Y = 9;
+  /// Depth slices between the near and far planes
+  static const int SLICES = 24;
+  static const int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+  /// Lights accepted per frame (extra lights are ignored)
+  static const int MAX_LIGHTS = 1024;
+  /// Light references across all clusters (extra references are dropped)
+  static const int MAX_LIGHT_INDICES = 64 * 1024;
+
+  ClusteredLights();
+  ~ClusteredLights();
+
+  ClusteredLights(const ClusteredLights &) = delete;
+  ClusteredLights &operator=(const ClusteredLights &) = delete;
+
+  /// Removes every light (call before adding this frame's lights)
+  void Clear();
+
+  /**
+   * @brief Adds a point light for this frame
+   * @param position World position
+   * @param radius Distance at which the light fades to zero
+   * @param color Light color times intensity
+   */
+  void AddLight(const glm::vec3 &position, float radius,
+                const glm::vec3 &color);
+
+  /**
+   * @brief Bins the lights for this camera and prepares the additive pass
+   *
+   * Uses the current GL viewport for the screen tiles.
+   *
+   * @param view Camera view matrix
+   * @param projection Camera projection matrix
+   * @param nearPlane Near plane distance of the projection
+   * @param farPlane Far plane distance of the projection
+   * @return Shader to draw the lit geometry with, or nullptr when no light
+   * is visible (skip the pass and do not call End)
+   */
+  Shader *Begin(const glm::mat4 &view, const glm::mat4 &projection,
+                float nearPlane, float farPlane);
+
+  /// Restores blending and depth state after the additive pass
+  void End();
+
+  /// Lights that passed culling in the last Begin
+  int VisibleLights() const { return visibleCount; }
+
+private:
+  /// World-space lights (structure of arrays)
+  std::vector<float> posX, posY, posZ, radius;
+  std::vector<glm::vec3> colors;
+
+  /// View-space positions of the current frame
+  std::vector<float> viewX, viewY, viewZ;
+
+  /// Per-cluster light count, then offset (CPU side of clusterGrid)
+  std::vector<unsigned int> clusterCounts, clusterRanges;
+  /// Cluster range covered by each visible light (x0, x1, y0, y1, z0, z1)
+  std::vector<int> lightBounds;
+  std::vector<unsigned int> visibleLights;
+  std::vector<unsigned int> lightIndices;
+  std::vector<float> lightTexels;
+  int visibleCount;
+
+  Shader *shader;
+  /// Texture buffers: light data, cluster ranges, light indices
+  unsigned int buffers[3];
+  unsigned int textures[3];
+
+  /**
+   * @brief Computes the clusters overlapped by a view-space sphere
+   * @return false if the sphere is outside the frustum depth range
+   */
+  bool ClusterBounds(float x, float y, float z, float r,
+                     const glm::mat4 &projection, float nearPlane,
+                     float farPlane, int bounds[6]) const;
+};
+
+#endif // CLUSTERED_LIGHTS_H
@@ -0,0 +1,96 @@
+/**
+ * @file DynamicResolution.h
+ * @brief Declaration of the DynamicResolution class - adaptive scene
+ * resolution
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+/**
+ * @brief Renders the 3D scene at a resolution that follows its GPU cost
+ *
+ * Between Begin and End the scene is drawn into an offscreen framebuffer
+ * at a fraction of the current viewport size, then stretched onto the
+ * framebuffer that was bound before (window or benchmark target) with a
+ * linear blit. UI drawn afterwards stays at native resolution.
+ *
+ * Update is fed the measured GPU time of the scene. When it leaves the
+ * target band the scale moves towards the value that would bring it back
+ * (GPU time is roughly proportional to the pixel count, i.e. scale^2).
+ * Adjustments are spaced out because timer results arrive a few frames
+ * late. The framebuffer is allocated at full viewport size and only a
+ * sub-rectangle is used, so changing the scale never reallocates.
+ */
+class DynamicResolution {
+public:
+  /// Lowest scale per axis (a quarter of the pixels)
+  static constexpr float MIN_SCALE = 0.5f;
+  /// Highest scale per axis (native resolution)
+  static constexpr float MAX_SCALE = 1.0f;
+  /// Fraction of the budget below which the scale goes back up
+  static constexpr float LOWER_BAND = 0.75f;
+  /// Frames between two adjustments (longer than the GPU timer latency)
+  static const int ADJUST_INTERVAL = 8;
+
+  /**
+   * @brief Creates the controller (GL objects are created on first use)
+   * @param budgetMilliseconds GPU time allowed for the scene
+   */
+  explicit DynamicResolution(float budgetMilliseconds);
+  ~DynamicResolution();
+
+  DynamicResolution(const DynamicResolution &) = delete;
+  DynamicResolution &operator=(const DynamicResolution &) = delete;
+
+  /**
+   * @brief Adjusts the scale from the latest scene GPU time
+   * @param gpuMilliseconds Measured GPU time of the scene (0 = unknown)
+   */
+  void Update(float gpuMilliseconds);
+
+  /**
+   * @brief Redirects rendering to the scaled offscreen target
+   *
+   * Remembers the bound framebuffer and viewport, binds the target, sets
+   * the scaled viewport and clears color and depth.
+   */
+  void Begin();
+
+  /**
+   * @brief Upscales the target onto the previous framebuffer and restores
+   * it and its viewport
+   */
+  void End();
+
+  /// Current scale per axis
+  float Scale() const { return scale; }
+
+private:
+  float budget;
+  float scale;
+  int framesSinceAdjust;
+
+  unsigned int framebuffer, colorBuffer, depthBuffer;
+  /// Allocated size of the target (full viewport size)
+  int targetWidth, targetHeight;
+
+  /// State saved by Begin
+  unsigned int previousFramebuffer;
+  int previousViewport[4];
+  /// Scaled size used by the current frame
+  int sceneWidth, sceneHeight;
+
+  /**
+   * @brief (Re)creates the attachments at the given size
+   * @return true if the framebuffer is complete
+   */
+  bool Allocate(int width, int height);
+
+  /// Deletes the framebuffer and its attachments
+  void Release();
+};
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -0,0 +1,77 @@
+/**
+ * @file ExplorationMap.h
+ * @brief Declaration of the ExplorationMap class - minimap fog of war
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef EXPLORATION_MAP_H
+#define EXPLORATION_MAP_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Maze;
+
+/**
+ * @brief Tracks which maze cells the player has already seen
+ *
+ * Stores one bit per cell. Visibility is found by casting rays through the
+ * grid from the player's cell; rays stop at the first wall, which is marked
+ * as seen too. Rays are only cast when the player enters a new cell, and
+ * only the cells that were not seen before are reported, so the minimap can
+ * update just those texels.
+ */
+class ExplorationMap {
+public:
+  /// Maximum ray length in cells
+  static const int MAX_RAY_CELLS = 24;
+
+  /// Number of rays cast around the player. More than 2 pi x the reach, so
+  /// neighbouring rays are less than a cell apart even at full length and
+  /// a one-cell corridor cannot slip between them.
+  static const int RAY_COUNT = 7 * MAX_RAY_CELLS;
+
+  ExplorationMap();
+
+  /**
+   * @brief Clears the map and sizes it for a maze
+   * @param width Maze width in cells
+   * @param height Maze height in cells
+   */
+  void Reset(int width, int height);
+
+  /**
+   * @brief Reveals what is visible from a position
+   *
+   * Does nothing if the player is still in the same cell as on the previous
+   * call.
+   *
+   * @param maze Maze used for wall occlusion
+   * @param playerCell Player position in grid coordinates (cells)
+   * @param revealed Receives the cells that became visible in this call
+   * @return true if at least one new cell was revealed
+   */
+  bool Update(const Maze &maze, const glm::vec2 &playerCell,
+              std::vector<glm::ivec2> &revealed);
+
+  /// Returns true if the cell has been seen
+  bool IsVisited(int x, int z) const;
+
+  /// Number of cells seen so far
+  size_t VisitedCount() const { return visitedCount; }
+
+private:
+  int width;
+  int height;
+  std::vector<uint64_t> visited;
+  size_t visitedCount;
+  glm::ivec2 lastCell;
+
+  bool MarkVisited(int x, int z);
+  void CastRay(const Maze &maze, const glm::vec2 &origin,
+               const glm::vec2 &dir, std::vector<glm::ivec2> &revealed);
+};
+
+#endif // EXPLORATION_MAP_H
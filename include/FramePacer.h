@@ -0,0 +1,101 @@
+/**
+ * @file FramePacer.h
+ * @brief Declaration of the FramePacer class - frame limiter and idle mode
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+struct GLFWwindow;
+
+/**
+ * @brief Paces the windowed main loop
+ *
+ * - Vsync: sets the swap interval of the window (on = 1, off = 0)
+ * - Frame cap: after each swap, waits until the next frame deadline. Most
+ *   of the wait is a sleep; the last SPIN_MARGIN is spun, because sleeps
+ *   routinely overshoot by a millisecond or more
+ * - Idle mode: while the scene is static (paused, intro dialog) or the
+ *   window is unfocused or minimized, the loop blocks in
+ *   glfwWaitEventsTimeout instead of polling, and re-presents a copy of
+ *   the last rendered frame instead of rendering the scene again
+ *
+ * Main loop usage:
+ *
+ *     pacer.PollEvents();
+ *     ... Advance ...
+ *     if (pacer.BeginFrame(game->IsIdle())) { clear; render; }
+ *     pacer.EndFrame(); // swaps and waits
+ *
+ * All calls are made on the render thread.
+ */
+class FramePacer {
+public:
+  /// Final part of a capped frame wait that is spun instead of slept
+  static constexpr double SPIN_MARGIN = 0.002;
+  /// Longest block in glfwWaitEventsTimeout while idle (seconds)
+  static constexpr double IDLE_TIMEOUT = 1.0 / 30.0;
+
+  /**
+   * @brief Applies the swap interval (the context must be current)
+   * @param window Window whose buffers are swapped
+   * @param vsync Synchronize swaps with the display refresh
+   * @param fpsCap Frame rate limit (0 = unlimited)
+   */
+  FramePacer(GLFWwindow *window, bool vsync, int fpsCap);
+  ~FramePacer();
+
+  FramePacer(const FramePacer &) = delete;
+  FramePacer &operator=(const FramePacer &) = delete;
+
+  /// Polls events, or waits for them (with a timeout) while idle
+  void PollEvents();
+
+  /**
+   * @brief Starts a frame
+   *
+   * When idle and a cached frame of the current size exists, the cached
+   * frame is copied to the back buffer and no rendering is needed.
+   *
+   * @param sceneIdle The scene does not change (paused, intro dialog)
+   * @return true if the caller must render the frame
+   */
+  bool BeginFrame(bool sceneIdle);
+
+  /// Caches the frame if idle, swaps buffers and applies the frame cap
+  void EndFrame();
+
+  /// True while the last BeginFrame was in idle mode
+  bool Idle() const { return idle; }
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  GLFWwindow *window;
+  int fpsCap;
+  Clock::time_point nextDeadline;
+
+  bool idle;
+  /// The back buffer holds the cached frame (nothing to store)
+  bool presentedCache;
+  /// Zero-sized framebuffer: nothing is drawn or swapped
+  bool minimized;
+
+  /// Copy of the last frame rendered while idle
+  unsigned int framebuffer, colorBuffer;
+  int cacheWidth, cacheHeight;
+  bool cacheValid;
+
+  /// Copies the back buffer into the cache, (re)allocating it if needed
+  void StoreFrame();
+  void ReleaseCache();
+
+  /// Sleeps, then spins, until the next frame deadline
+  void WaitForDeadline();
+};
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,349 @@
+/**
+ * @file GLStateCache.h
+ * @brief Shadow copy of the GL binding and fixed-function state
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include "RenderStats.h"
+#include "glad/glad.h"
+
+/**
+ * @brief Tracks the GL state the renderer changes and skips redundant calls
+ *
+ * Shadows the current program, vertex array, the 2D and buffer textures of
+ * every texture unit, the array/texture/pixel-unpack buffer bindings, the
+ * draw and read framebuffers, the viewport, the blend, depth, scissor and
+ * cull enables, the blend function, the depth function and the depth and
+ * color write masks. A call that would set a value GL already has is
+ * skipped and counted as saved in RenderStats; every issued call is counted
+ * as a state change. Queries of the framebuffer and viewport are answered
+ * from the shadow once known.
+ *
+ * The shadow starts unknown, so the first call of each kind always reaches
+ * GL. Code that changes tracked state must go through the cache (or call
+ * Invalidate afterwards). Objects must be deleted through the Delete*
+ * helpers so a recycled name is not mistaken for a bound one.
+ * GL_ELEMENT_ARRAY_BUFFER is vertex array state and is not tracked, nor are
+ * targets and capabilities outside the lists above (those calls are passed
+ * straight to GL).
+ *
+ * Only the render thread (the thread owning the context) may use it.
+ */
+class GLStateCache {
+public:
+  /// Texture units tracked (higher units are passed through)
+  static const int TEXTURE_UNITS = 16;
+
+  /// Cache of the current context
+  static GLStateCache &Get() {
+    static GLStateCache cache;
+    return cache;
+  }
+
+  /// Forgets everything; the next call of each kind reaches GL
+  void Invalidate() {
+    program = vertexArray = activeUnit = UNKNOWN;
+    for (int unit = 0; unit < TEXTURE_UNITS; unit++)
+      for (int target = 0; target < TEXTURE_TARGETS; target++)
+        textures[unit][target] = UNKNOWN;
+    for (int target = 0; target < BUFFER_TARGETS; target++)
+      buffers[target] = UNKNOWN;
+    for (int cap = 0; cap < CAPABILITIES; cap++)
+      enabled[cap] = -1;
+    drawFramebuffer = readFramebuffer = UNKNOWN;
+    viewportKnown = false;
+    blendSource = blendDestination = depthFunction = UNKNOWN;
+    depthMask = colorMask = -1;
+  }
+
+  void UseProgram(GLuint id) {
+    if (Same(program, id))
+      return;
+    glUseProgram(id);
+  }
+
+  void BindVertexArray(GLuint id) {
+    if (Same(vertexArray, id))
+      return;
+    glBindVertexArray(id);
+  }
+
+  /// Selects the texture unit that later BindTexture(target, id) calls use
+  void ActiveTexture(GLuint unit) {
+    if (Same(activeUnit, unit))
+      return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+
+  /// Binds a texture on the active unit (also used for uploads)
+  void BindTexture(GLenum target, GLuint id) {
+    int slot = TextureSlot(target);
+    if (slot < 0 || activeUnit >= static_cast<GLuint>(TEXTURE_UNITS)) {
+      glBindTexture(target, id);
+      RenderStats::RecordStateChange();
+      return;
+    }
+    if (Same(textures[activeUnit][slot], id))
+      return;
+    glBindTexture(target, id);
+  }
+
+  /// Binds a texture on a given unit, switching the active unit only if
+  /// the binding actually changes
+  void BindTexture(GLuint unit, GLenum target, GLuint id) {
+    int slot = TextureSlot(target);
+    if (slot >= 0 && unit < static_cast<GLuint>(TEXTURE_UNITS) &&
+        textures[unit][slot] == id) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    ActiveTexture(unit);
+    BindTexture(target, id);
+  }
+
+  void BindBuffer(GLenum target, GLuint id) {
+    int slot = BufferSlot(target);
+    if (slot < 0) {
+      glBindBuffer(target, id);
+      RenderStats::RecordStateChange();
+      return;
+    }
+    if (Same(buffers[slot], id))
+      return;
+    glBindBuffer(target, id);
+  }
+
+  /// glBindFramebuffer; GL_FRAMEBUFFER sets the draw and read bindings
+  void BindFramebuffer(GLenum target, GLuint id) {
+    bool draw = target != GL_READ_FRAMEBUFFER;
+    bool read = target != GL_DRAW_FRAMEBUFFER;
+    if ((!draw || drawFramebuffer == id) && (!read || readFramebuffer == id)) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    if (draw)
+      drawFramebuffer = id;
+    if (read)
+      readFramebuffer = id;
+    glBindFramebuffer(target, id);
+    RenderStats::RecordStateChange();
+  }
+
+  /// Current draw framebuffer (GL is only asked while it is unknown)
+  GLuint DrawFramebuffer() {
+    if (drawFramebuffer == UNKNOWN) {
+      GLint id = 0;
+      glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &id);
+      drawFramebuffer = static_cast<GLuint>(id);
+    }
+    return drawFramebuffer;
+  }
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (viewportKnown && viewport[0] == x && viewport[1] == y &&
+        viewport[2] == width && viewport[3] == height) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = width;
+    viewport[3] = height;
+    viewportKnown = true;
+    glViewport(x, y, width, height);
+    RenderStats::RecordStateChange();
+  }
+
+  /// Current viewport as x, y, width, height (GL is only asked while it is
+  /// unknown)
+  void GetViewport(GLint out[4]) {
+    if (!viewportKnown) {
+      glGetIntegerv(GL_VIEWPORT, viewport);
+      viewportKnown = true;
+    }
+    for (int i = 0; i < 4; i++)
+      out[i] = viewport[i];
+  }
+
+  /// glEnable / glDisable
+  void SetEnabled(GLenum cap, bool enable) {
+    int slot = CapabilitySlot(cap);
+    if (slot >= 0) {
+      if (enabled[slot] == static_cast<signed char>(enable)) {
+        RenderStats::RecordSavedCall();
+        return;
+      }
+      enabled[slot] = static_cast<signed char>(enable);
+    }
+    if (enable)
+      glEnable(cap);
+    else
+      glDisable(cap);
+    RenderStats::RecordStateChange();
+  }
+
+  /// glIsEnabled, answered from the shadow once known (no driver round trip)
+  bool IsEnabled(GLenum cap) {
+    int slot = CapabilitySlot(cap);
+    if (slot < 0)
+      return glIsEnabled(cap) == GL_TRUE;
+    if (enabled[slot] < 0)
+      enabled[slot] = glIsEnabled(cap) == GL_TRUE ? 1 : 0;
+    return enabled[slot] == 1;
+  }
+
+  void BlendFunc(GLenum source, GLenum destination) {
+    if (blendSource == source && blendDestination == destination) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    blendSource = source;
+    blendDestination = destination;
+    glBlendFunc(source, destination);
+    RenderStats::RecordStateChange();
+  }
+
+  void DepthFunc(GLenum function) {
+    if (Same(depthFunction, function))
+      return;
+    glDepthFunc(function);
+  }
+
+  void DepthMask(bool write) {
+    if (depthMask == static_cast<signed char>(write)) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    depthMask = static_cast<signed char>(write);
+    glDepthMask(write ? GL_TRUE : GL_FALSE);
+    RenderStats::RecordStateChange();
+  }
+
+  /// glColorMask with the same value for all four channels
+  void ColorMask(bool write) {
+    if (colorMask == static_cast<signed char>(write)) {
+      RenderStats::RecordSavedCall();
+      return;
+    }
+    colorMask = static_cast<signed char>(write);
+    GLboolean value = write ? GL_TRUE : GL_FALSE;
+    glColorMask(value, value, value, value);
+    RenderStats::RecordStateChange();
+  }
+
+  /// glDeleteTextures; deleted names revert to 0 in the shadow as in GL
+  void DeleteTextures(GLsizei count, const GLuint *ids) {
+    for (GLsizei i = 0; i < count; i++)
+      for (int unit = 0; unit < TEXTURE_UNITS; unit++)
+        for (int target = 0; target < TEXTURE_TARGETS; target++)
+          if (ids[i] != 0 && textures[unit][target] == ids[i])
+            textures[unit][target] = 0;
+    glDeleteTextures(count, ids);
+  }
+
+  void DeleteBuffers(GLsizei count, const GLuint *ids) {
+    for (GLsizei i = 0; i < count; i++)
+      for (int target = 0; target < BUFFER_TARGETS; target++)
+        if (ids[i] != 0 && buffers[target] == ids[i])
+          buffers[target] = 0;
+    glDeleteBuffers(count, ids);
+  }
+
+  void DeleteFramebuffers(GLsizei count, const GLuint *ids) {
+    for (GLsizei i = 0; i < count; i++) {
+      if (ids[i] != 0 && drawFramebuffer == ids[i])
+        drawFramebuffer = 0;
+      if (ids[i] != 0 && readFramebuffer == ids[i])
+        readFramebuffer = 0;
+    }
+    glDeleteFramebuffers(count, ids);
+  }
+
+  void DeleteVertexArrays(GLsizei count, const GLuint *ids) {
+    for (GLsizei i = 0; i < count; i++)
+      if (ids[i] != 0 && vertexArray == ids[i])
+        vertexArray = 0;
+    glDeleteVertexArrays(count, ids);
+  }
+
+private:
+  static const GLuint UNKNOWN = 0xFFFFFFFFu;
+  /// GL_TEXTURE_2D, GL_TEXTURE_BUFFER
+  static const int TEXTURE_TARGETS = 2;
+  /// GL_ARRAY_BUFFER, GL_TEXTURE_BUFFER, GL_PIXEL_UNPACK_BUFFER
+  static const int BUFFER_TARGETS = 3;
+  /// GL_BLEND, GL_DEPTH_TEST, GL_SCISSOR_TEST, GL_CULL_FACE
+  static const int CAPABILITIES = 4;
+
+  GLuint program, vertexArray, activeUnit;
+  GLuint textures[TEXTURE_UNITS][TEXTURE_TARGETS];
+  GLuint buffers[BUFFER_TARGETS];
+  GLuint drawFramebuffer, readFramebuffer;
+  GLint viewport[4];
+  bool viewportKnown;
+  /// -1 unknown, 0 disabled, 1 enabled
+  signed char enabled[CAPABILITIES];
+  GLenum blendSource, blendDestination, depthFunction;
+  signed char depthMask, colorMask;
+
+  GLStateCache() { Invalidate(); }
+
+  /**
+   * @brief Updates a shadowed value and counts the call
+   * @return true if GL already has the value (skip the call)
+   */
+  static bool Same(GLuint &shadow, GLuint value) {
+    if (shadow == value) {
+      RenderStats::RecordSavedCall();
+      return true;
+    }
+    shadow = value;
+    RenderStats::RecordStateChange();
+    return false;
+  }
+
+  static int TextureSlot(GLenum target) {
+    switch (target) {
+    case GL_TEXTURE_2D:
+      return 0;
+    case GL_TEXTURE_BUFFER:
+      return 1;
+    default:
+      return -1;
+    }
+  }
+
+  static int BufferSlot(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:
+      return 0;
+    case GL_TEXTURE_BUFFER:
+      return 1;
+    case GL_PIXEL_UNPACK_BUFFER:
+      return 2;
+    default:
+      return -1;
+    }
+  }
+
+  static int CapabilitySlot(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:
+      return 0;
+    case GL_DEPTH_TEST:
+      return 1;
+    case GL_SCISSOR_TEST:
+      return 2;
+    case GL_CULL_FACE:
+      return 3;
+    default:
+      return -1;
+    }
+  }
+};
+
+#endif // GL_STATE_CACHE_H
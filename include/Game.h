@@ -10,6 +10,10 @@
 
 #include "../include/learnopengl/camera.h"
 #include "Maze.h"
+#include "TripleBuffer.h"
+
+#include <atomic>
+#include <thread>
 
 // ============================================================================
 // FORWARD DECLARATIONS
@@ -18,6 +22,8 @@
 /// Forward declaration of GLFW window
 struct GLFWwindow;
 
+struct LaunchOptions;
+
 // ============================================================================
 // ENUMS
 // ============================================================================
@@ -33,6 +39,37 @@ enum class GameMode {
   CLIENT ///< Client mode
 };
 
+// ============================================================================
+// FRAME SNAPSHOT
+// ============================================================================
+
+/**
+ * @brief Everything the renderer needs from one simulation tick
+ *
+ * Written by the simulation at the end of each tick and handed to the render
+ * thread through a TripleBuffer, so rendering never reads state that the
+ * simulation is modifying.
+ */
+struct FrameSnapshot {
+  /// Player camera at the end of the tick
+  Camera View;
+  /// Camera position at the start of the tick (for interpolation)
+  glm::vec3 PreviousPosition = glm::vec3(0.0f);
+  /// glfwGetTime() when the tick finished
+  double TickTime = 0.0;
+
+  bool ShowingIntroDialog = true;
+  bool IsPaused = false;
+  /// Ambient tint from portal proximity (GetEnvironmentTint)
+  glm::vec3 EnvironmentTint = glm::vec3(1.0f);
+  /// Number of maze cells spanned by the minimap side
+  float MinimapViewCells = 64.0f;
+  /// Performance HUD visible (F3)
+  bool ShowPerfHud = false;
+  /// Depth-only pass before shading the scene (F4)
+  bool DepthPrepass = false;
+};
+
 // ============================================================================
 // GAME CLASSE
 // ============================================================================
@@ -57,8 +94,9 @@ public:
   // GAME STATE
   // ========================================================================
 
-  /// Key state array (true = pressed)
-  bool Keys[1024];
+  /// Key state array (true = pressed). Written by the GLFW callbacks and
+  /// read by the simulation, which may run on another thread.
+  std::atomic<bool> Keys[1024];
 
   /// Window width in pixels
   unsigned int Width;
@@ -66,6 +104,16 @@ public:
   /// Window height in pixels
   unsigned int Height;
 
+  /// Seed of the maze generator (random unless set by ConfigureInputLog)
+  uint32_t mazeSeed;
+
+  /// Length of one simulation tick in seconds (120 Hz)
+  static constexpr float SIMULATION_STEP = 1.0f / 120.0f;
+
+  /// Longest frame time simulated at once (avoids a spiral of death after
+  /// a hitch or a breakpoint)
+  static constexpr float MAX_FRAME_TIME = 0.25f;
+
   // ========================================================================
   // NETWORKING
   // ========================================================================
@@ -116,6 +164,15 @@ public:
   /// Positions of all trees in the scene
   std::vector<glm::vec3> treePositions;
 
+  /// Positions of the torches along the corridors
+  std::vector<glm::vec3> torchPositions;
+
+  /// Torch and portal point lights (clustered additive pass)
+  class ClusteredLights *clusteredLights;
+
+  /// Sorted draw list of the 3D scene, refilled every frame
+  class RenderQueue *renderQueue;
+
   /// Mesh of the portal at the end of the maze
   Mesh *gateMesh;
 
@@ -135,6 +192,17 @@ public:
   /// Pointer to the window (for cursor control)
   GLFWwindow *windowPtr;
 
+  /// Scene GPU budget in milliseconds for dynamic resolution (0 = always
+  /// native resolution). Read by Init.
+  float sceneBudget;
+
+  /// Texture memory limit in bytes (0 = unlimited). Read by Init.
+  size_t textureBudget;
+
+  /// Draw a depth-only pass before shading the scene, so each pixel is
+  /// shaded once (toggled with F4, simulation side)
+  bool depthPrepass;
+
   // ========================================================================
   // CONSTRUCTOR AND DESTRUCTOR
   // ========================================================================
@@ -167,11 +235,45 @@ public:
    */
   void Init();
 
+  /**
+   * @brief Sets up input recording or replay (see InputRecorder)
+   *
+   * Uses `--record`, `--replay` and `--seed`. A replay takes its maze seed
+   * from the log. Call before Init.
+   *
+   * @param options Parsed command line
+   * @return false if a log could not be opened
+   */
+  bool ConfigureInputLog(const LaunchOptions &options);
+
+  /// True once a replayed log has run out of ticks
+  bool ReplayFinished() const { return replayFinished; }
+
+  /**
+   * @brief True while the picture does not change (paused or intro dialog)
+   *
+   * Reads the latest snapshot, so call it on the render thread after
+   * Advance. Used by FramePacer to re-present a cached frame. Never idle
+   * while textures are still arriving (they change the picture).
+   */
+  bool IsIdle() const {
+    const FrameSnapshot &latest = snapshots.Read();
+    return (latest.IsPaused || latest.ShowingIntroDialog) && !texturesLoading;
+  }
+
+  /**
+   * @brief Uploads every texture still loading, ignoring the frame budget
+   *
+   * Used by the benchmark so the measured frames do not include uploads.
+   */
+  void FinishTextureLoads();
+
   /**
    * @brief Processes keyboard input
    *
    * Handles keys for movement (WASD/arrows), pause (ESC),
-   * fullscreen (F) and dialog interaction (ENTER).
+   * fullscreen (F), minimap zoom (+/-), performance HUD (F3) and dialog
+   * interaction (ENTER).
    *
    * @param dt Delta time for framerate-independent movement
    */
@@ -180,14 +282,15 @@ public:
   /**
    * @brief Processes mouse movement
    *
-   * Updates camera orientation based on mouse movement.
+   * The offsets are accumulated and applied to the camera orientation at
+   * the start of the next simulation tick (pitch is constrained to prevent
+   * flipping). Safe to call from the GLFW callback while the simulation
+   * runs on another thread.
    *
    * @param xoffset Horizontal mouse offset
    * @param yoffset Vertical mouse offset
-   * @param constrainPitch Limits vertical rotation (prevents flip)
    */
-  void ProcessMouseMovement(float xoffset, float yoffset,
-                            bool constrainPitch = true);
+  void ProcessMouseMovement(float xoffset, float yoffset);
 
   /**
    * @brief Updates game logic
@@ -199,12 +302,45 @@ public:
    */
   void Update(float dt);
 
+  /**
+   * @brief Advances the simulation by a frame's worth of time
+   *
+   * Frame time is accumulated and consumed in fixed SIMULATION_STEP ticks,
+   * each running ProcessInput and Update. Movement and collision therefore
+   * behave the same at any frame rate (a tick never moves the player more
+   * than MovementSpeed * SIMULATION_STEP, so walls cannot be skipped).
+   *
+   * @param frameTime Real time since the previous call, in seconds
+   * @return Interpolation factor in [0, 1) between the last two ticks
+   */
+  float Advance(float frameTime);
+
+  /**
+   * @brief Moves the simulation to its own thread
+   *
+   * From then on ticks run on that thread at SIMULATION_STEP intervals and
+   * Advance only picks up the latest snapshot, so slow network polling or
+   * game logic never delays frame submission. Call after Init, once
+   * windowPtr is set.
+   */
+  void StartSimulationThread();
+
+  /**
+   * @brief Stops and joins the simulation thread (no-op if not running)
+   */
+  void StopSimulationThread();
+
   /**
    * @brief Renders the entire scene
    *
-   * Draws the maze, outdoor environment, portal and UI overlays.
+   * Draws the maze, outdoor environment, portal and UI overlays. The camera
+   * is placed between its position at the previous and at the latest
+   * simulation tick, so motion stays smooth when the frame rate and the
+   * tick rate differ.
+   *
+   * @param alpha Interpolation factor returned by Advance (1 = latest tick)
    */
-  void Render();
+  void Render(float alpha = 1.0f);
 
   // ========================================================================
   // HELPER METHODS
@@ -222,7 +358,8 @@ public:
    * @brief Calculates color tint based on portal proximity
    *
    * The closer to the portal, the more the ambient color shifts to
-   * blue/cyan tones, creating a progressive visual effect.
+   * blue/cyan tones, creating a progressive visual effect. Simulation
+   * side; the renderer uses the value stored in the frame snapshot.
    *
    * @return RGB vector with the calculated tint
    */
@@ -238,6 +375,105 @@ public:
   void RenderPauseOverlay();
 
 private:
+  // ========================================================================
+  // FIXED TIMESTEP
+  // ========================================================================
+
+  /// Real time not yet consumed by simulation ticks
+  float simulationAccumulator;
+
+  /// Camera position at the start of the latest tick (for interpolation)
+  glm::vec3 previousCameraPosition;
+
+  // ========================================================================
+  // SIMULATION / RENDER HAND-OFF
+  // ========================================================================
+
+  /// Snapshots published by the simulation, consumed by Advance/Render
+  TripleBuffer<FrameSnapshot> snapshots;
+
+  /// Snapshot being rendered (render thread only)
+  FrameSnapshot frame;
+
+  /// Camera used for rendering: frame.View at the interpolated position
+  Camera renderCamera;
+
+  /// Simulation thread (see StartSimulationThread)
+  std::thread simulationThread;
+
+  /// Cleared to ask the simulation thread to exit
+  std::atomic<bool> simulationRunning;
+
+  /// Mouse movement not yet applied by a tick
+  std::atomic<float> pendingMouseX, pendingMouseY;
+
+  /// Cursor mode requested by the simulation (-1 = no request)
+  std::atomic<int> requestedCursorMode;
+
+  /// Fullscreen toggles requested by the simulation
+  std::atomic<int> requestedFullscreenToggles;
+
+  // ========================================================================
+  // INPUT RECORD / REPLAY
+  // ========================================================================
+
+  /// Key state seen by the current tick: a copy of Keys, or the replayed
+  /// state (ProcessInput reads only this, so a tick sees consistent keys)
+  bool tickKeys[1024];
+
+  /// Records or replays tick input (null when neither is requested)
+  class InputRecorder *inputRecorder;
+
+  /// Set when the replayed log is exhausted; ticks stop running
+  std::atomic<bool> replayFinished;
+
+  /**
+   * @brief Runs one simulation tick and publishes its snapshot
+   */
+  void RunTick();
+
+  /**
+   * @brief Copies the state the renderer needs into a new snapshot
+   */
+  void PublishSnapshot();
+
+  /**
+   * @brief Applies GLFW window changes requested by the simulation
+   *
+   * GLFW window functions may only be called from the main thread.
+   */
+  void ApplyWindowRequests();
+
+  /**
+   * @brief Body of the simulation thread
+   */
+  void SimulationLoop();
+
+  /**
+   * @brief Draws the scene from renderCamera and the current frame snapshot
+   */
+  void RenderScene();
+
+  /**
+   * @brief Reports the textures of a mesh to the texture manager
+   *
+   * Colour maps count as more important than normal and roughness maps
+   * when the texture memory budget forces levels out.
+   *
+   * @param mesh Mesh drawn this frame (may be null)
+   * @param distance Distance from the camera to its nearest instance
+   */
+  void RequestTextures(const Mesh *mesh, float distance);
+
+  /**
+   * @brief Sets the flashlight and camera uniforms of a scene shader variant
+   * @param shader Variant in use
+   * @param projection Projection matrix
+   * @param view View matrix
+   */
+  void SetSceneUniforms(class Shader &shader, const glm::mat4 &projection,
+                        const glm::mat4 &view);
+
   // ========================================================================
   // PRIVATE RESOURCES (OVERLAY)
   // ========================================================================
@@ -254,6 +490,12 @@ private:
   /// Flag indicating if overlay resources have been initialized
   bool overlayResourcesInitialized;
 
+  /// Cached text of the intro dialog (shaped once, one draw call)
+  class TextLayout *introLayout;
+
+  /// Cached text of the pause overlay (shaped once, one draw call)
+  class TextLayout *pauseLayout;
+
   /**
    * @brief Initializes OpenGL resources for the overlay
    *
@@ -291,14 +533,64 @@ private:
    */
   class Shader *simpleShader;
 
+  /**
+   * @brief Tiled occupancy pyramid that backs the minimap
+   *
+   * Only the tiles inside the current minimap view are uploaded and drawn,
+   * so the minimap cost does not grow with the maze size.
+   */
+  class MinimapPyramid *minimapPyramid;
+
+  /**
+   * @brief Cells already seen by the player (minimap fog of war)
+   */
+  class ExplorationMap *explorationMap;
+
+  /**
+   * @brief Reveals the cells visible from the player on the minimap
+   *
+   * Only does work when the player enters a new cell; newly seen cells are
+   * forwarded to the minimap pyramid. Called by Render with renderCamera.
+   */
+  void UpdateExploration();
+
+  /**
+   * @brief Number of maze cells spanned by the minimap side
+   *
+   * Changed with +/- (zoom). The view follows the player.
+   */
+  float minimapViewCells;
+
+  /**
+   * @brief Frame timing and render counters overlay (see PerfHud)
+   */
+  class PerfHud *perfHud;
+
+  /**
+   * @brief Background texture loading and mip streaming under the memory
+   * budget (see TextureManager)
+   */
+  class TextureManager *textureManager;
+
+  /// Textures were still loading at the start of the last Render
+  bool texturesLoading;
+
+  /// Performance HUD toggled on (simulation side, see FrameSnapshot)
+  bool showPerfHud;
+
+  /**
+   * @brief Scaled offscreen target of the 3D scene (null when disabled)
+   */
+  class DynamicResolution *dynamicResolution;
+
   /**
    * @brief Renders the 2D Minimap
    *
-   * Draws a top-down representation of the maze in the
-   * top-right corner of the screen, showing:
-   * - Walls (Black)
+   * Draws a top-down representation of the explored part of the maze
+   * around the player in the top-right corner of the screen, showing:
+   * - Seen walls (Black) and corridors (Light Gray)
+   * - Unexplored cells (Dark Gray fog)
    * - Player (Red)
-   * - Background (Dark Gray)
    *
    * @note Uses 2D orthographic projection.
    */
@@ -0,0 +1,59 @@
+/**
+ * @file GpuTimer.h
+ * @brief Declaration of the GpuTimer class - non-blocking GPU time queries
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+/**
+ * @brief Measures the GPU time of a block of GL commands
+ *
+ * Wraps a small ring of GL_TIME_ELAPSED query objects. Results are read a
+ * few frames later, only once the driver reports them available, so timing
+ * never stalls the pipeline. If every query in the ring is still in flight
+ * the frame is simply not measured.
+ *
+ * Only one GL_TIME_ELAPSED query can be active at a time, so Begin/End
+ * pairs of different timers must not overlap.
+ */
+class GpuTimer {
+public:
+  /// Number of queries in flight before frames are skipped
+  static const int RING_SIZE = 4;
+
+  GpuTimer();
+  ~GpuTimer();
+
+  GpuTimer(const GpuTimer &) = delete;
+  GpuTimer &operator=(const GpuTimer &) = delete;
+
+  /// Starts timing (skipped if no query is free)
+  void Begin();
+
+  /// Stops timing started by the matching Begin
+  void End();
+
+  /**
+   * @brief Collects finished queries without waiting
+   * @return Most recent GPU time in milliseconds (0 until the first result)
+   */
+  float Poll();
+
+  /// Most recent result in milliseconds (as returned by the last Poll)
+  float LastMilliseconds() const { return lastMilliseconds; }
+
+private:
+  unsigned int queries[RING_SIZE];
+  /// Next query to start and oldest query in flight
+  int writeIndex, readIndex;
+  /// Number of queries issued and not read back
+  int pending;
+  /// True between a Begin that started a query and its End
+  bool active;
+  float lastMilliseconds;
+};
+
+#endif // GPU_TIMER_H
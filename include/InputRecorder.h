@@ -0,0 +1,97 @@
+/**
+ * @file InputRecorder.h
+ * @brief Declaration of the InputRecorder class - input record and replay
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records the input of every simulation tick to a file and plays it
+ * back
+ *
+ * A log holds the maze seed followed by one entry per tick: the tick's dt,
+ * the mouse movement applied by the tick and the keys whose state changed
+ * since the previous tick. Replaying a log with the same seed feeds
+ * ProcessInput and Update exactly the same sequence, so a session becomes
+ * a repeatable workload (e.g. for `--headless` frame-time comparisons).
+ *
+ * File layout (little endian):
+ * - header: magic "MZIN", version, seed (3 x uint32)
+ * - per tick: dt, mouse x, mouse y (3 x float), changed key count
+ *   (uint16), changed key codes (uint16 each)
+ */
+class InputRecorder {
+public:
+  /// Size of the key state arrays (matches Game::Keys)
+  static const int KEY_COUNT = 1024;
+
+  InputRecorder();
+  ~InputRecorder();
+
+  InputRecorder(const InputRecorder &) = delete;
+  InputRecorder &operator=(const InputRecorder &) = delete;
+
+  /**
+   * @brief Starts writing a new log
+   * @param path Output file
+   * @param seed Maze seed of the session
+   * @return true if the file could be created
+   */
+  bool StartRecording(const std::string &path, uint32_t seed);
+
+  /**
+   * @brief Loads a log for replay
+   * @param path Log written by a recording session
+   * @return true if the log is valid
+   */
+  bool StartReplay(const std::string &path);
+
+  /// True while writing a log
+  bool IsRecording() const { return file != nullptr; }
+
+  /// True once a log has been loaded for replay
+  bool IsReplaying() const { return replaying; }
+
+  /// Maze seed of the recorded or replayed session
+  uint32_t Seed() const { return seed; }
+
+  /**
+   * @brief Appends one tick to the log
+   * @param keys Key state used by the tick (KEY_COUNT entries)
+   * @param mouseX Horizontal mouse movement applied by the tick
+   * @param mouseY Vertical mouse movement applied by the tick
+   * @param dt Tick length in seconds
+   */
+  void RecordTick(const bool *keys, float mouseX, float mouseY, float dt);
+
+  /**
+   * @brief Reads the next tick of the log
+   * @param keys Key state, updated with the recorded changes
+   * @param mouseX Receives the recorded horizontal mouse movement
+   * @param mouseY Receives the recorded vertical mouse movement
+   * @param dt Receives the recorded tick length
+   * @return false when the log is exhausted (outputs untouched)
+   */
+  bool ReplayTick(bool *keys, float &mouseX, float &mouseY, float &dt);
+
+private:
+  /// Recording output (null when not recording)
+  FILE *file;
+  bool replaying;
+  uint32_t seed;
+  /// Key state of the previous recorded tick
+  bool lastKeys[KEY_COUNT];
+  /// Loaded log and read position (replay)
+  std::vector<unsigned char> log;
+  size_t readOffset;
+};
+
+#endif // INPUT_RECORDER_H
@@ -0,0 +1,142 @@
+/**
+ * @file LaunchOptions.h
+ * @brief Command-line options shared by the host and client executables
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef LAUNCH_OPTIONS_H
+#define LAUNCH_OPTIONS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Options parsed from the command line
+ *
+ * Usage: `<executable> [host_ip] [options]`
+ *
+ * - `--single-thread` runs the simulation on the render thread
+ * - `--headless` renders a fixed number of frames offscreen and reports
+ *   frame times (see Benchmark)
+ * - `--frames=N` number of measured frames in headless mode
+ * - `--egl` asks GLFW for an EGL context (headless on Mesa/llvmpipe)
+ * - `--dump-frames=DIR` writes frames as PPM images in headless mode
+ * - `--dump-every=N` dumps one frame out of N (default 60)
+ * - `--record=FILE` records the input of every tick (see InputRecorder)
+ * - `--replay=FILE` replays a recorded log instead of live input, then
+ *   exits; with `--headless` the whole log is measured
+ * - `--seed=N` fixed maze seed (a replay uses the recorded seed)
+ * - `--scene-budget=MS` GPU time allowed for the 3D scene before its
+ *   resolution drops (default 12, 0 = always native resolution)
+ * - `--depth-prepass` starts with the depth pre-pass on (toggled with F4)
+ * - `--no-vsync` swaps without waiting for the display refresh
+ * - `--fps-cap=N` limits the frame rate (default 0 = unlimited)
+ * - `--texture-budget=MB` texture memory limit; distant and less important
+ *   textures lose their top mip levels to stay under it (default 0 =
+ *   unlimited)
+ * - `--trace=FILE` Chrome trace written on exit (builds with
+ *   MAZE_ENABLE_TRACING only, default trace.json)
+ */
+struct LaunchOptions {
+  /// Host IP address (first positional argument)
+  std::string hostIP = "127.0.0.1";
+  /// True if an IP was given on the command line
+  bool hostIPProvided = false;
+  /// Run the simulation on its own thread
+  bool simulationThread = true;
+
+  /// Render offscreen for a fixed number of frames, then exit
+  bool headless = false;
+  /// Frames measured in headless mode
+  int benchmarkFrames = 600;
+  /// Create the context through EGL instead of GLX/WGL/CGL
+  bool egl = false;
+  /// Directory for dumped frames (empty = no dumps)
+  std::string dumpDirectory;
+  /// Interval between dumped frames
+  int dumpEvery = 60;
+
+  /// Input log to write (empty = no recording)
+  std::string recordFile;
+  /// Input log to replay (empty = live input)
+  std::string replayFile;
+  /// Maze seed given with --seed
+  uint32_t mazeSeed = 0;
+  /// True if --seed was given
+  bool seedProvided = false;
+
+  /// Scene GPU budget in milliseconds for dynamic resolution (0 = off)
+  float sceneBudget = 12.0f;
+  /// Start with the depth pre-pass enabled
+  bool depthPrepass = false;
+
+  /// Synchronize buffer swaps with the display (see FramePacer)
+  bool vsync = true;
+  /// Frame rate limit of the windowed loop (0 = unlimited)
+  int fpsCap = 0;
+
+  /// Texture memory limit in megabytes (0 = unlimited, see TextureManager)
+  int textureBudget = 0;
+
+  /// Chrome trace output (see Trace)
+  std::string traceFile = "trace.json";
+
+  /**
+   * @brief Parses the command line, warning about unknown options
+   * @param argc Argument count
+   * @param argv Argument values
+   * @return Parsed options
+   */
+  static LaunchOptions Parse(int argc, char *argv[]) {
+    LaunchOptions options;
+    for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg == "--single-thread") {
+        options.simulationThread = false;
+      } else if (arg == "--headless") {
+        options.headless = true;
+      } else if (arg.rfind("--frames=", 0) == 0) {
+        options.benchmarkFrames = std::max(1, std::atoi(arg.c_str() + 9));
+      } else if (arg == "--egl") {
+        options.egl = true;
+      } else if (arg.rfind("--dump-frames=", 0) == 0) {
+        options.dumpDirectory = arg.substr(14);
+      } else if (arg.rfind("--dump-every=", 0) == 0) {
+        options.dumpEvery = std::max(1, std::atoi(arg.c_str() + 13));
+      } else if (arg.rfind("--record=", 0) == 0) {
+        options.recordFile = arg.substr(9);
+      } else if (arg.rfind("--replay=", 0) == 0) {
+        options.replayFile = arg.substr(9);
+      } else if (arg.rfind("--seed=", 0) == 0) {
+        options.mazeSeed =
+            static_cast<uint32_t>(std::strtoul(arg.c_str() + 7, nullptr, 10));
+        options.seedProvided = true;
+      } else if (arg.rfind("--scene-budget=", 0) == 0) {
+        options.sceneBudget =
+            std::max(0.0f, static_cast<float>(std::atof(arg.c_str() + 15)));
+      } else if (arg == "--depth-prepass") {
+        options.depthPrepass = true;
+      } else if (arg == "--no-vsync") {
+        options.vsync = false;
+      } else if (arg.rfind("--fps-cap=", 0) == 0) {
+        options.fpsCap = std::max(0, std::atoi(arg.c_str() + 10));
+      } else if (arg.rfind("--texture-budget=", 0) == 0) {
+        options.textureBudget = std::max(0, std::atoi(arg.c_str() + 17));
+      } else if (arg.rfind("--trace=", 0) == 0) {
+        options.traceFile = arg.substr(8);
+      } else if (arg.rfind("--", 0) == 0) {
+        std::cout << "WARNING: Unknown option ignored: " << arg << std::endl;
+      } else {
+        options.hostIP = arg;
+        options.hostIPProvided = true;
+      }
+    }
+    return options;
+  }
+};
+
+#endif // LAUNCH_OPTIONS_H
@@ -0,0 +1,59 @@
+/**
+ * @file MappedFile.h
+ * @brief Declaration of the MappedFile class - read-only file mappings
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A whole file mapped read-only into memory
+ *
+ * Used for cooked assets (see TextureCache, MeshCache): the pages are read
+ * on first touch and shared with the OS file cache, so a warm start copies
+ * nothing until the data is handed to GL. On Windows the file is read into
+ * memory instead.
+ */
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief Maps a file, closing the previous one
+   * @param path File to map
+   * @return false if the file is missing or empty
+   */
+  bool Open(const std::string &path);
+
+  /// Unmaps the file
+  void Close();
+
+  /// True while a file is mapped
+  bool IsOpen() const { return data != nullptr; }
+
+  /// First byte of the file
+  const unsigned char *Data() const { return data; }
+
+  /// Size of the file in bytes
+  size_t Size() const { return size; }
+
+private:
+  const unsigned char *data;
+  size_t size;
+  /// File contents where mapping is not available
+  std::vector<unsigned char> contents;
+};
+
+#endif // MAPPED_FILE_H
@@ -13,6 +13,8 @@
 #include "kruksal/kruksal.h"
 #include <vector>
 
+class RenderQueue;
+
 /**
  * @brief Class that represents and manages the 3D maze
  *
@@ -97,19 +99,24 @@ public:
    *
    * @param w Desired width (number of cells)
    * @param h Desired height (number of cells)
+   * @param seed Random seed; the same seed and size give the same maze
    */
-  void Generate(int w, int h);
+  void Generate(int w, int h, uint32_t seed);
 
   /**
-   * @brief Renders the maze
+   * @brief Queues the maze for rendering
    *
-   * Draws all walls and floor cells using the provided
-   * meshes. Iterates through the grid and draws each cell according
-   * to its type (wall or floor).
+   * Submits one draw per cell (wall or floor mesh, according to its type)
+   * with its model matrix, objectColor and view depth. The queue orders
+   * them; the shader must already render textured surfaces.
    *
-   * @param shader Reference to the shader used for rendering
+   * @param queue Render queue of the frame
+   * @param pass Queue pass of the draws
+   * @param shader Shader used for rendering
+   * @param view Camera view matrix (for the depth of each cell)
    */
-  void Draw(Shader &shader);
+  void Submit(RenderQueue &queue, unsigned int pass, Shader &shader,
+              const glm::mat4 &view);
 
   /**
    * @brief Checks if a 3D position contains a wall
@@ -1,6 +1,8 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include "GLStateCache.h"
+#include "RenderStats.h"
 #include "Texture.h"
 #include "glad/glad.h"
 #include <glm/glm.hpp>
@@ -67,10 +69,34 @@ public:
     this->vertices = vertices;
     this->indices = indices;
     this->textures = textures;
-    setupMesh(); // Configure buffers
+    // Configure buffers
+    setupMesh(this->vertices.data(), this->vertices.size(),
+              this->indices.data(), this->indices.size());
 
   }
 
+  /**
+   * @brief Mesh Constructor from packed vertex and index data
+
+   *
+   * The data is uploaded as is and not kept (vertices and indices stay
+   * empty), so it can come straight from a memory-mapped cooked mesh
+   * (see MeshCache).
+   *
+   * @param vertexData Vertices
+   * @param vertexCount Number of vertices
+   * @param indexData Triangle indices (may be null if indexCount is 0)
+   * @param indexCount Number of indices
+   * @param textures Vector of textures
+
+   */
+  Mesh(const Vertex *vertexData, size_t vertexCount,
+       const unsigned int *indexData, size_t indexCount,
+       std::vector<Texture> textures) {
+    this->textures = textures;
+    setupMesh(vertexData, vertexCount, indexData, indexCount);
+  }
+
   // Draws the mesh
 
   void Draw(GLuint shaderProgram) {
@@ -80,9 +106,8 @@ public:
     unsigned int normalNr = 1;
     unsigned int heightNr = 1;
     unsigned int roughnessNr = 1;
+    GLStateCache &state = GLStateCache::Get();
     for (unsigned int i = 0; i < textures.size(); i++) {
-      glActiveTexture(GL_TEXTURE0 +
-                      i); // active proper texture unit before binding
       // retrieve texture number (the N in diffuse_textureN)
       std::string number;
       std::string name = textures[i].type;
@@ -102,8 +127,9 @@ public:
       // now set the sampler to the correct texture unit
       glUniform1i(glGetUniformLocation(shaderProgram, (name + number).c_str()),
                   i);
-      // and finally bind the texture
-      glBindTexture(GL_TEXTURE_2D, textures[i].id);
+      // and finally bind the texture (the unit is only switched if the
+      // binding changes)
+      state.BindTexture(i, GL_TEXTURE_2D, textures[i].id);
     }
 
     // For this specific simple shader that uses "texture1", we might want a
@@ -123,43 +149,54 @@ public:
       glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
     }
 
-    glBindVertexArray(VAO);
-    if (!indices.empty()) {
+    DrawGeometry();
+  }
+
+  // Draws the triangles only, without binding textures (depth pre-pass)
+
+  void DrawGeometry() {
+    GLStateCache::Get().BindVertexArray(VAO);
+    if (indexCount > 0) {
       // Draw with indices if they exist
 
-      glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+      glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+      RenderStats::RecordDraw(indexCount);
     } else {
       // Draw vertex array
 
-      glDrawArrays(GL_TRIANGLES, 0, vertices.size());
+      glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+      RenderStats::RecordDraw(vertexCount);
     }
-    glBindVertexArray(0); // Unbind VAO
-
-
-    // always good practice to set everything back to defaults once configured.
-    glActiveTexture(GL_TEXTURE0);
+    // The VAO and texture units stay bound: the state cache skips them when
+    // the next draw uses the same ones
   }
 
 private:
   unsigned int VAO, VBO, EBO;
+  /// Sizes of the uploaded buffers (the vectors may be empty)
+  size_t vertexCount, indexCount;
 
   // Configures mesh buffers (VAO, VBO, EBO)
 
-  void setupMesh() {
+  void setupMesh(const Vertex *vertexData, size_t vertexCount,
+                 const unsigned int *indexData, size_t indexCount) {
+    this->vertexCount = vertexCount;
+    this->indexCount = indexCount;
+
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex),
-                 &vertices[0], GL_STATIC_DRAW);
+    GLStateCache &state = GLStateCache::Get();
+    state.BindVertexArray(VAO);
+    state.BindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertexData,
+                 GL_STATIC_DRAW);
 
-    if (!indices.empty()) {
+    if (indexCount > 0) {
       glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   indices.size() * sizeof(unsigned int), &indices[0],
-                   GL_STATIC_DRAW);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int),
+                   indexData, GL_STATIC_DRAW);
     }
 
     // Attribute 0: Position
@@ -176,7 +213,7 @@ private:
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
                           (void *)offsetof(Vertex, TexCoords));
 
-    glBindVertexArray(0);
+    state.BindVertexArray(0);
   }
 };
 
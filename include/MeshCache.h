@@ -0,0 +1,94 @@
+/**
+ * @file MeshCache.h
+ * @brief Declaration of the MeshCache class - cooked meshes on disk
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include "MappedFile.h"
+#include "Mesh.hpp"
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Vertex and index buffers of a model, ready to upload as is
+ *
+ * The data either lives in a memory-mapped cache file or, right after
+ * cooking, in memory owned by the object.
+ */
+class CookedMesh {
+public:
+  const Vertex *Vertices;
+  size_t VertexCount;
+  /// Triangle list indices into Vertices
+  const unsigned int *Indices;
+  size_t IndexCount;
+  /// Axis-aligned bounds of the vertex positions
+  glm::vec3 BoundsMin, BoundsMax;
+
+  CookedMesh();
+
+  CookedMesh(const CookedMesh &) = delete;
+  CookedMesh &operator=(const CookedMesh &) = delete;
+
+  /// Unmaps or frees the buffers; the object becomes empty
+  void Release();
+
+  /// True if the mesh holds vertices
+  bool Valid() const { return Vertices != nullptr; }
+
+private:
+  friend class MeshCache;
+
+  /// Buffers cooked in this run
+  std::vector<Vertex> vertexStorage;
+  std::vector<unsigned int> indexStorage;
+  /// Cache file holding the buffers (closed if they are in storage)
+  MappedFile file;
+};
+
+/**
+ * @brief Converts OBJ models into GPU-ready buffers, cooked once
+ *
+ * The first time a model is requested it is parsed with ObjParser, on all
+ * cores. All groups are merged, identical position/normal/UV combinations share one
+ * vertex through an index buffer, and the model is moved so it is centred
+ * on X/Z and rests on y = 0, then scaled. The result is written to the
+ * "meshes" category of AssetCache, keyed by the source file's path, size
+ * and modification time and by the scale. Later launches map the file:
+ * its buffers go straight to glBufferData.
+ *
+ * File layout (little-endian):
+ *
+ *     uint32 magic, version, vertexSize, vertexCount, indexCount, reserved
+ *     float  boundsMin[3], boundsMax[3]
+ *     Vertex vertices[vertexCount]
+ *     uint32 indices[indexCount]
+ *
+ * Nothing here touches GL. All methods are static, no instantiation is
+ * required.
+ */
+class MeshCache {
+public:
+  /**
+   * @brief Gets the cooked form of an OBJ model, cooking it if needed
+   * @param path Source OBJ file
+   * @param scale Uniform scale applied after centring
+   * @param mesh Filled with the cooked mesh
+   * @return false if the model could not be loaded or has no faces
+   */
+  static bool LoadObj(const std::string &path, float scale, CookedMesh &mesh);
+
+private:
+  static bool MapCooked(const std::string &cachePath, CookedMesh &mesh);
+  static bool CookObj(const std::string &path, float scale, CookedMesh &mesh);
+  static void WriteCooked(const std::string &cachePath,
+                          const CookedMesh &mesh);
+};
+
+#endif // MESH_CACHE_H
@@ -0,0 +1,123 @@
+/**
+ * @file MinimapPyramid.h
+ * @brief Declaration of the MinimapPyramid class - tiled, mip-style minimap
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef MINIMAP_PYRAMID_H
+#define MINIMAP_PYRAMID_H
+
+#include "glad/glad.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+class Maze;
+
+/**
+ * @brief Hierarchical occupancy pyramid used to draw the minimap
+ *
+ * Level 0 stores one RG texel per maze cell: G = 255 once the cell has been
+ * seen by the player and R = 255 if it is a seen wall. Every following level
+ * halves the resolution by averaging 2x2 blocks, so a texel of level L covers
+ * 2^L x 2^L cells and holds the fraction of seen cells (G) and of seen walls
+ * (R). Unseen cells are drawn as fog.
+ *
+ * Each level is cut into square tiles of TILE_SIZE texels. Tiles are only
+ * uploaded to the GPU when they fall inside the minimap view and are kept in
+ * a small LRU cache, so the per-frame cost depends on the minimap size in
+ * pixels and not on the maze dimensions.
+ */
+class MinimapPyramid {
+public:
+  /// Width/height of a tile in texels
+  static const int TILE_SIZE = 128;
+
+  /// Maximum number of tile textures kept on the GPU at once
+  static const size_t MAX_RESIDENT_TILES = 64;
+
+  /// Maximum number of tiles uploaded during a single frame
+  static const int MAX_UPLOADS_PER_FRAME = 8;
+
+  MinimapPyramid();
+  ~MinimapPyramid();
+
+  /**
+   * @brief Builds the CPU side of the pyramid from the maze grid
+   *
+   * Drops any tiles that were uploaded for a previous maze.
+   *
+   * @param maze Maze whose grid is sampled
+   * @param revealAll Start with every cell seen (no fog of war)
+   */
+  void Build(const Maze &maze, bool revealAll = false);
+
+  /**
+   * @brief Marks cells as seen
+   *
+   * Updates level 0 and the affected texels of the coarser levels. Tiles
+   * that are resident on the GPU only record the dirty rectangle; it is
+   * uploaded with glTexSubImage2D the next time the tile is drawn.
+   *
+   * @param cells Newly seen cells (grid coordinates)
+   */
+  void Reveal(const std::vector<glm::ivec2> &cells);
+
+  /**
+   * @brief Draws the visible part of the pyramid into a screen rectangle
+   *
+   * Picks the level whose texels are closest to one screen pixel, streams in
+   * the tiles intersecting the view and draws them clipped to the rectangle.
+   *
+   * @param center View center in grid coordinates (cells)
+   * @param viewCells Number of cells spanned by the minimap side
+   * @param rectX Left edge of the minimap in pixels
+   * @param rectY Bottom edge of the minimap in pixels
+   * @param rectSize Side of the minimap in pixels
+   * @param projection Orthographic screen projection
+   */
+  void Render(const glm::vec2 &center, float viewCells, float rectX,
+              float rectY, float rectSize, const glm::mat4 &projection);
+
+  /// Number of levels in the pyramid (0 if not built)
+  int LevelCount() const { return static_cast<int>(levels.size()); }
+
+private:
+  /// One resolution level of the pyramid
+  struct Level {
+    int width;                        ///< Width in texels
+    int height;                       ///< Height in texels
+    int tilesX;                       ///< Number of tile columns
+    int tilesY;                       ///< Number of tile rows
+    std::vector<unsigned char> texels; ///< Row-major RG pairs (seen wall, seen)
+  };
+
+  /// A tile currently resident on the GPU
+  struct Tile {
+    unsigned int texture; ///< GL_RG8 texture with the tile texels
+    uint64_t lastUsed;    ///< Frame in which the tile was last drawn
+    int dirtyX0, dirtyY0; ///< Dirty rectangle (tile texels, inclusive)
+    int dirtyX1, dirtyY1; ///< Empty when dirtyX0 > dirtyX1
+  };
+
+  std::vector<Level> levels;
+  std::vector<bool> baseWalls;
+  std::unordered_map<uint64_t, Tile> residentTiles;
+  uint64_t frameCounter;
+
+  unsigned int shaderProgram;
+  unsigned int VAO, VBO;
+  int projectionLoc, rectLoc;
+
+  static uint64_t TileKey(int level, int tx, int ty);
+  void InitializeResources();
+  void ReleaseTiles();
+  unsigned int AcquireTile(int level, int tx, int ty, int &uploadsLeft);
+  void UploadTile(unsigned int texture, int level, int tx, int ty);
+  void UploadDirtyRect(Tile &tile, int level, int tx, int ty);
+  void MarkDirty(int level, int x, int y);
+};
+
+#endif // MINIMAP_PYRAMID_H
@@ -0,0 +1,68 @@
+/**
+ * @file ObjParser.h
+ * @brief Declaration of the ObjParser class - multi-threaded OBJ parsing
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Geometry of an OBJ file, with every face split into triangles
+ */
+struct ObjData {
+  /// Vertex positions (x, y, z per vertex)
+  std::vector<float> Positions;
+  /// Vertex normals (x, y, z per normal)
+  std::vector<float> Normals;
+  /// Texture coordinates (u, v per coordinate)
+  std::vector<float> TexCoords;
+  /**
+   * Triangle corners, three ints each: position, normal and texture
+   * coordinate index (0-based; -1 for a missing normal or coordinate)
+   */
+  std::vector<int> Corners;
+
+  /// Number of triangles
+  size_t TriangleCount() const { return Corners.size() / 9; }
+};
+
+/**
+ * @brief Parses OBJ geometry on all cores
+ *
+ * The file is mapped (see MappedFile) and split into line-aligned chunks of
+ * at least MIN_CHUNK bytes, one per hardware thread. Each thread parses its
+ * chunk into its own buffers: `v`, `vn`, `vt` and `f` lines are read,
+ * polygons are fanned into triangles, everything else (groups, materials,
+ * smoothing) is skipped. Absolute indices are global already; relative
+ * (negative) indices are recorded against the chunk and fixed up once the
+ * element counts of all earlier chunks are known. The merge then copies
+ * every chunk into place, again one thread per chunk.
+ *
+ * Small files (a single chunk) are parsed on the calling thread. All
+ * methods are static, no instantiation is required.
+ */
+class ObjParser {
+public:
+  /// Smallest chunk worth a thread of its own
+  static const size_t MIN_CHUNK = 1u << 20;
+
+  /**
+   * @brief Parses an OBJ file
+   *
+   * Errors (missing file, indices out of range) are printed to cerr.
+   *
+   * @param path OBJ file
+   * @param data Filled with the geometry
+   * @return false if the file could not be read or references missing
+   * elements
+   */
+  static bool Parse(const std::string &path, ObjData &data);
+};
+
+#endif // OBJ_PARSER_H
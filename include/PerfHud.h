@@ -0,0 +1,116 @@
+/**
+ * @file PerfHud.h
+ * @brief Declaration of the PerfHud class - in-game performance overlay
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include "GpuTimer.h"
+#include "RenderStats.h"
+#include "TextLayout.h"
+#include <atomic>
+#include <cstddef>
+
+class TextRenderer;
+
+/**
+ * @brief Shows where frame time goes: CPU time per phase, GPU time per pass
+ * and the draw-call, triangle and state-change counts of the last frame,
+ * plus the resident texture memory
+ *
+ * CPU phases are timed by the caller (Now() before and after) and smoothed
+ * with an exponential moving average. Input and update run on the
+ * simulation thread, so each phase value is an atomic with a single writer.
+ * GPU passes use GpuTimer (non-blocking GL_TIME_ELAPSED queries). The text
+ * is refreshed a few times per second and drawn from a cached TextLayout.
+ */
+class PerfHud {
+public:
+  /// CPU phases
+  enum CpuPhase {
+    CPU_INPUT,   ///< Game::ProcessInput
+    CPU_UPDATE,  ///< Game::Update
+    CPU_RENDER,  ///< Whole Game::Render
+    CPU_MINIMAP, ///< Game::RenderMinimap
+    CPU_UI,      ///< Dialogs, overlays and the HUD itself
+    CPU_PHASE_COUNT
+  };
+
+  /// GPU passes (must not overlap)
+  enum GpuPass {
+    GPU_SCENE,   ///< 3D scene
+    GPU_MINIMAP, ///< Minimap
+    GPU_UI,      ///< Dialogs, overlays and the HUD itself
+    GPU_PASS_COUNT
+  };
+
+  /// Text refreshes per second
+  static constexpr double REFRESH_RATE = 4.0;
+
+  PerfHud();
+
+  /// Current time in milliseconds (monotonic clock)
+  static double Now();
+
+  /**
+   * @brief Adds a measurement to a CPU phase
+   * @param phase Measured phase
+   * @param milliseconds Time spent in the phase
+   */
+  void RecordCpu(CpuPhase phase, double milliseconds);
+
+  /// Starts timing a GPU pass
+  void BeginGpu(GpuPass pass) { gpuTimers[pass].Begin(); }
+
+  /// Stops timing a GPU pass
+  void EndGpu(GpuPass pass) { gpuTimers[pass].End(); }
+
+  /// Latest GPU time of a pass in milliseconds (0 until measured)
+  float GpuMilliseconds(GpuPass pass) const {
+    return gpuTimers[pass].LastMilliseconds();
+  }
+
+  /// Scene resolution scale shown by the overlay (1 = native)
+  void SetResolutionScale(float scale) { resolutionScale = scale; }
+
+  /// Depth pre-pass state shown by the overlay
+  void SetDepthPrepass(bool enabled) { depthPrepass = enabled; }
+
+  /// Texture memory shown by the overlay, in bytes (budget 0 = unlimited)
+  void SetTextureMemory(size_t resident, size_t budget) {
+    textureBytes = resident;
+    textureBudget = budget;
+  }
+
+  /**
+   * @brief Starts a new frame
+   *
+   * Keeps the counters of the finished frame for display, resets them and
+   * collects finished GPU queries.
+   */
+  void BeginFrame();
+
+  /**
+   * @brief Draws the overlay in the top-left corner
+   * @param renderer Text renderer
+   * @param width Viewport width in pixels
+   * @param height Viewport height in pixels
+   */
+  void Draw(TextRenderer &renderer, unsigned int width, unsigned int height);
+
+private:
+  std::atomic<float> cpuMilliseconds[CPU_PHASE_COUNT];
+  GpuTimer gpuTimers[GPU_PASS_COUNT];
+  /// Counters of the last complete frame
+  RenderStats lastFrame;
+  TextLayout layout;
+  double lastRefresh;
+  float resolutionScale;
+  bool depthPrepass;
+  size_t textureBytes, textureBudget;
+};
+
+#endif // PERF_HUD_H
@@ -0,0 +1,122 @@
+/**
+ * @file RenderQueue.h
+ * @brief Declaration of the RenderQueue class - sorted scene draw list
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Mesh;
+class Shader;
+
+/**
+ * @brief Collects the mesh draws of a frame and issues them in key order
+ *
+ * Every draw is submitted with a 64-bit sort key:
+ *
+ *     | pass (4) | program (12) | material (16) | view depth (32) |
+ *
+ * so draws are grouped by pass, then by program, then by material (the
+ * mesh's first texture), and drawn front to back inside a group, which
+ * lets the depth test reject hidden fragments early. The depth field is
+ * the bit pattern of the non-negative view-space depth, which orders like
+ * the float itself.
+ *
+ * Keys are sorted with an LSD radix sort (8-bit digits) over an index
+ * array; digits that are equal for every key (usually the pass and
+ * program bytes) are skipped. Program and texture binds go through the GL
+ * state cache, so draws sharing them after the sort cost no state change.
+ *
+ * Per-program uniforms (camera, lights, time) must be set before Execute;
+ * each item only sets "model" and "objectColor".
+ *
+ * ExecuteDepthOnly draws the same items with a trivial program and color
+ * writes off. Run before Execute with the depth test set to GL_EQUAL and
+ * depth writes off, every pixel is then shaded once, by its visible
+ * surface. GL_EQUAL needs identical depths: the pre-pass program and the
+ * scene programs (through ShaderVariants) both declare `invariant
+ * gl_Position`, which GLSL only honours for the same expression from the
+ * same inputs, so scene shaders must compute projection * view * model *
+ * position.
+ */
+class RenderQueue {
+public:
+  /// Queue passes, drawn in this order
+  enum Pass : unsigned int { PASS_OPAQUE = 0, PASS_LIGHTING = 1 };
+
+  RenderQueue();
+  ~RenderQueue();
+
+  RenderQueue(const RenderQueue &) = delete;
+  RenderQueue &operator=(const RenderQueue &) = delete;
+
+  /// Empties the queue (the storage is kept for the next frame)
+  void Clear();
+
+  /**
+   * @brief Adds a mesh draw
+   * @param pass Pass the draw belongs to
+   * @param shader Program to draw with
+   * @param mesh Mesh to draw
+   * @param model Model matrix
+   * @param color objectColor of the draw
+   * @param viewDepth Distance along the view direction (for ordering)
+   */
+  void Submit(unsigned int pass, Shader &shader, Mesh &mesh,
+              const glm::mat4 &model, const glm::vec3 &color,
+              float viewDepth);
+
+  /// Sorts the submitted draws by key
+  void Sort();
+
+  /// Issues the draws in sorted order
+  void Execute() const;
+
+  /**
+   * @brief Lays down the depth of the queued draws without shading
+   *
+   * Color writes are off during the pass and restored afterwards. The
+   * pre-pass program is built on first use.
+   *
+   * @param view Camera view matrix
+   * @param projection Camera projection matrix
+   */
+  void ExecuteDepthOnly(const glm::mat4 &view, const glm::mat4 &projection);
+
+  /// Draws currently queued
+  size_t Size() const { return items.size(); }
+
+  /**
+   * @brief Builds a sort key
+   * @param pass Pass (4 bits)
+   * @param program GL program name (low 12 bits are used)
+   * @param material Texture name, 0 if untextured (low 16 bits are used)
+   * @param viewDepth View depth, negative values count as 0
+   */
+  static uint64_t MakeKey(unsigned int pass, unsigned int program,
+                          unsigned int material, float viewDepth);
+
+private:
+  struct Item {
+    Shader *shader;
+    Mesh *mesh;
+    glm::mat4 model;
+    glm::vec3 color;
+  };
+
+  std::vector<Item> items;
+  std::vector<uint64_t> keys;
+  /// Item indices in draw order, and the radix sort scratch buffer
+  std::vector<uint32_t> order, scratch;
+
+  /// Depth-only program of the pre-pass (null until first used)
+  Shader *depthShader;
+};
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,51 @@
+/**
+ * @file RenderStats.h
+ * @brief Per-frame counters of draw calls, triangles and GL state changes
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+/**
+ * @brief Counters filled by the code that issues GL calls
+ *
+ * Every draw call site reports its vertex count. GLStateCache reports each
+ * state call it issues, and each one it skips as redundant. The performance
+ * HUD reads the totals of the previous frame. Only the render thread
+ * touches the counters.
+ */
+struct RenderStats {
+  unsigned int drawCalls = 0;
+  unsigned int triangles = 0;
+  unsigned int stateChanges = 0;
+  /// Redundant state calls skipped by GLStateCache
+  unsigned int savedCalls = 0;
+
+  /// Counters of the frame being rendered
+  static RenderStats &Current() {
+    static RenderStats stats;
+    return stats;
+  }
+
+  /**
+   * @brief Records a draw call of GL_TRIANGLES
+   * @param vertexCount Number of vertices (or indices) drawn
+   */
+  static void RecordDraw(unsigned int vertexCount) {
+    RenderStats &stats = Current();
+    stats.drawCalls++;
+    stats.triangles += vertexCount / 3;
+  }
+
+  /// Records a program, texture or vertex array bind
+  static void RecordStateChange(unsigned int count = 1) {
+    Current().stateChanges += count;
+  }
+
+  /// Records a state call that was skipped because it changed nothing
+  static void RecordSavedCall() { Current().savedCalls++; }
+};
+
+#endif // RENDER_STATS_H
@@ -8,6 +8,8 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include "GLStateCache.h"
+#include "ShaderCache.h"
 #include "glad/glad.h"
 #include <fstream>
 #include <iostream>
@@ -35,14 +37,15 @@ public:
    * @brief Constructor - loads and compiles shaders
    *
    * Reads the vertex and fragment shader files, compiles them,
-   * and links them to create the shader program.
+   * and links them to create the shader program. The linked program is
+   * cached on disk (ShaderCache), so later launches skip compilation.
    *
    * @param vertexPath Path to the vertex shader file
    * @param fragmentPath Path to the fragment shader file
    *
    * @throws std::ifstream::failure if unable to read the files
    *
-   * @note Compilation/linking errors are printed to cout
+   * @note Compilation/linking errors are printed to cerr
    */
   Shader(const char *vertexPath, const char *fragmentPath) {
     // 1. Read shader code
@@ -71,43 +74,31 @@ public:
       std::cout << "ERROR: Shader file not read successfully" << std::endl;
     }
 
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-
-    // 2. Compile shaders
-    unsigned int vertex, fragment;
-
-    // Vertex shader
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
-
-    // Fragment shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
-
-    // Shader program
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
-
-    // Delete shaders (already linked)
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    // 2. Compile and link (or reuse the binary from a previous run)
+    ID = ShaderCache::BuildProgram(vertexPath, vertexCode, fragmentCode);
+  }
+
+  /**
+   * @brief Constructor - builds a program from in-memory sources
+   *
+   * Same as the file constructor for shaders embedded in the code.
+   *
+   * @param name Label used in error messages and in the program cache
+   * @param vertexCode Vertex shader source
+   * @param fragmentCode Fragment shader source
+   */
+  Shader(const std::string &name, const std::string &vertexCode,
+         const std::string &fragmentCode) {
+    ID = ShaderCache::BuildProgram(name, vertexCode, fragmentCode);
   }
 
   /**
    * @brief Activates this shader for rendering
    *
-   * Calls glUseProgram with this shader's ID.
-   * All subsequent rendering calls will use this shader.
+   * Calls glUseProgram with this shader's ID (skipped when it is already
+   * current). All subsequent rendering calls will use this shader.
    */
-  void use() { glUseProgram(ID); }
+  void use() { GLStateCache::Get().UseProgram(ID); }
 
   /**
    * @brief Sets boolean uniform
@@ -170,34 +161,6 @@ public:
                        value);
   }
 
-private:
-  /**
-   * @brief Checks for compilation/linking errors
-   *
-   * Prints detailed error messages if compilation
-   * or linking fails.
-   *
-   * @param shader ID of the shader or program to check
-   * @param type Type of check ("VERTEX", "FRAGMENT" or "PROGRAM")
-   */
-  void checkCompileErrors(unsigned int shader, std::string type) {
-    int success;
-    char infoLog[1024];
-    if (type != "PROGRAM") {
-      glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-      if (!success) {
-        glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-        std::cout << "SHADER COMPILATION ERROR type: " << type << "\n"
-                  << infoLog << std::endl;
-      }
-    } else {
-      glGetProgramiv(shader, GL_LINK_STATUS, &success);
-      if (!success) {
-        glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-        std::cout << "PROGRAM LINKING ERROR\n" << infoLog << std::endl;
-      }
-    }
-  }
 };
 
 #endif // SHADER_H
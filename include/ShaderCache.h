@@ -0,0 +1,50 @@
+/**
+ * @file ShaderCache.h
+ * @brief Declaration of the ShaderCache class - on-disk program binaries
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <string>
+
+/**
+ * @brief Builds shader programs, reusing linked binaries from earlier runs
+ *
+ * Programs are keyed by a hash of their GLSL sources and of the GL vendor,
+ * renderer and version strings, so a driver update or an edited shader
+ * simply misses the cache. On a hit the program is loaded with
+ * glProgramBinary and no GLSL is compiled. On a miss (or if the driver
+ * rejects the binary, or ARB_get_program_binary is unavailable) the sources
+ * are compiled and linked as usual and the binary is stored for the next
+ * launch. Files live in the "shaders" category of AssetCache.
+ *
+ * All methods are static, no instantiation is required.
+ */
+class ShaderCache {
+public:
+  /**
+   * @brief Creates a program from vertex and fragment shader sources
+   *
+   * Compilation and link errors are printed to cerr, prefixed by `name`.
+   *
+   * @param name Label used in error messages (e.g. "Overlay")
+   * @param vertexSource GLSL vertex shader source
+   * @param fragmentSource GLSL fragment shader source
+   * @return Program ID (0 only if program creation itself failed)
+   */
+  static unsigned int BuildProgram(const std::string &name,
+                                   const std::string &vertexSource,
+                                   const std::string &fragmentSource);
+
+private:
+  static unsigned int LoadBinary(const std::string &path);
+  static void SaveBinary(const std::string &path, unsigned int program);
+  static unsigned int Compile(const std::string &name,
+                              const std::string &vertexSource,
+                              const std::string &fragmentSource);
+};
+
+#endif // SHADER_CACHE_H
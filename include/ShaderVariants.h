@@ -0,0 +1,88 @@
+/**
+ * @file ShaderVariants.h
+ * @brief Declaration of the ShaderVariants class - specialized shader
+ * permutations
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Shader;
+
+/**
+ * @brief Builds one program per combination of boolean shader features
+ *
+ * Each feature is a `uniform bool` of the shader source. A variant is
+ * selected by a bitmask (bit i = feature i enabled) and compiled once, on
+ * first use, from a specialized copy of the sources:
+ * - `#define <DEFINE> 0|1` is inserted after the `#version` line, for
+ *   code written with `#if`
+ * - `uniform bool <name>;` becomes `const bool <name> = true|false;`, so
+ *   existing `if (name)` branches are folded away by the compiler and the
+ *   renderer no longer sets the uniform between draws
+ *
+ * The vertex shader is also given `invariant gl_Position;`, so its depths
+ * match bit for bit those of the other passes that declare it (depth
+ * pre-pass, clustered lights) and compute the same
+ * `projection * view * model * position` expression.
+ *
+ * Specialized sources differ, so every variant gets its own entry in the
+ * program binary cache (ShaderCache).
+ */
+class ShaderVariants {
+public:
+  /// One boolean feature
+  struct Feature {
+    /// Name of the `uniform bool` it replaces
+    const char *uniform;
+    /// Preprocessor symbol defined to 0 or 1
+    const char *define;
+  };
+
+  /**
+   * @brief Reads the shader sources (nothing is compiled yet)
+   * @param vertexPath Path to the vertex shader file
+   * @param fragmentPath Path to the fragment shader file
+   * @param features Features, bit i of a mask selects features[i]
+   */
+  ShaderVariants(const std::string &vertexPath,
+                 const std::string &fragmentPath,
+                 const std::vector<Feature> &features);
+  ~ShaderVariants();
+
+  ShaderVariants(const ShaderVariants &) = delete;
+  ShaderVariants &operator=(const ShaderVariants &) = delete;
+
+  /**
+   * @brief Returns the program of a feature combination, building it if
+   * needed
+   * @param mask Enabled features
+   * @return Specialized shader
+   */
+  Shader &Get(unsigned int mask);
+
+  /**
+   * @brief Specializes one shader source for a feature mask
+   * @param source GLSL source starting with a `#version` line
+   * @param features Feature list
+   * @param mask Enabled features
+   * @return Specialized source
+   */
+  static std::string Specialize(const std::string &source,
+                                const std::vector<Feature> &features,
+                                unsigned int mask);
+
+private:
+  std::string name;
+  std::string vertexSource, fragmentSource;
+  std::vector<Feature> features;
+  std::unordered_map<unsigned int, Shader *> programs;
+};
+
+#endif // SHADER_VARIANTS_H
@@ -0,0 +1,36 @@
+/**
+ * @file SignedDistanceField.h
+ * @brief Conversion of coverage bitmaps into signed distance fields
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef SIGNED_DISTANCE_FIELD_H
+#define SIGNED_DISTANCE_FIELD_H
+
+#include <vector>
+
+/**
+ * @brief Builds a low-resolution signed distance field from a high-resolution
+ * coverage bitmap
+ *
+ * The bitmap is thresholded at 50% coverage and an exact-ish Euclidean
+ * distance transform (8SSEDT) is run on it in both directions. Each output
+ * texel samples the distance at the center of its `downscale` x `downscale`
+ * block and stores it as 0.5 + distance / (2 * spread), clamped to [0, 1]
+ * and scaled to a byte: values above 128 are inside the shape. `spread` is
+ * given in output pixels.
+ *
+ * @param bitmap High-resolution coverage (one byte per pixel)
+ * @param width Bitmap width in pixels (multiple of downscale)
+ * @param height Bitmap height in pixels (multiple of downscale)
+ * @param downscale Ratio between the bitmap and the output resolution
+ * @param spread Distance (output pixels) mapped to the full byte range
+ * @return Field of (width / downscale) x (height / downscale) bytes
+ */
+std::vector<unsigned char>
+GenerateSignedDistanceField(const std::vector<unsigned char> &bitmap,
+                            int width, int height, int downscale,
+                            float spread);
+
+#endif // SIGNED_DISTANCE_FIELD_H
@@ -0,0 +1,104 @@
+/**
+ * @file TextLayout.h
+ * @brief Declaration of the TextLayout class - cached geometry for static text
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+class TextRenderer;
+
+/**
+ * @brief A block of text lines shaped once and drawn from a cached buffer
+ *
+ * The lines are turned into quads and uploaded to a VBO the first time the
+ * layout is drawn. The geometry (and the width of each line, used for
+ * centering) is only rebuilt when a line's text, scale, color or position
+ * changes, when the viewport changes, or when the TextRenderer reloads or
+ * evicts glyphs. Otherwise drawing the whole block is a single draw call with no
+ * CPU-side text work.
+ */
+class TextLayout {
+public:
+  /// Horizontal placement of a line
+  enum class Align {
+    LEFT,  ///< x is the left edge of the line
+    CENTER ///< Line is centered on the viewport, x is ignored
+  };
+
+  TextLayout();
+  ~TextLayout();
+
+  TextLayout(const TextLayout &) = delete;
+  TextLayout &operator=(const TextLayout &) = delete;
+
+  /**
+   * @brief Sets the viewport the layout is placed in
+   * @param width Viewport width in pixels
+   * @param height Viewport height in pixels
+   */
+  void SetViewport(unsigned int width, unsigned int height);
+
+  /**
+   * @brief Sets (or adds) a line of the layout
+   *
+   * Cheap when nothing changed: the values are compared with the cached
+   * ones and the layout is only marked dirty on a difference.
+   *
+   * @param index Line index (the layout grows as needed)
+   * @param text Line text
+   * @param x Screen X position (ignored for Align::CENTER)
+   * @param y Screen Y position of the baseline
+   * @param scale Scaling factor
+   * @param color Text color (RGB)
+   * @param align Horizontal placement
+   */
+  void SetLine(size_t index, const char *text, float x, float y, float scale,
+               glm::vec3 color, Align align = Align::CENTER);
+
+  /**
+   * @brief Removes lines past the given count
+   * @param count Number of lines to keep
+   */
+  void Truncate(size_t count);
+
+  /**
+   * @brief Draws the layout, rebuilding the geometry first if needed
+   * @param renderer Renderer providing glyphs, atlas and shader
+   */
+  void Draw(TextRenderer &renderer);
+
+  /**
+   * @brief Width of a line in pixels (valid after the first Draw)
+   * @param index Line index
+   */
+  float GetLineWidth(size_t index) const;
+
+private:
+  /// One line as given by the caller, plus its cached width
+  struct Line {
+    std::string text;
+    float x, y, scale;
+    glm::vec3 color;
+    Align align;
+    float width;
+  };
+
+  std::vector<Line> lines;
+  unsigned int viewportWidth, viewportHeight;
+  bool dirty;
+  unsigned int builtGeneration;
+
+  unsigned int VAO, VBO;
+  int vertexCount;
+
+  void Rebuild(TextRenderer &renderer);
+};
+
+#endif // TEXT_LAYOUT_H
@@ -6,26 +6,69 @@
 #include <glm/glm.hpp>
 #include FT_FREETYPE_H
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-// Character info storing texture data
+// Character info storing the glyph location inside the atlas
 struct Character {
-  unsigned int TextureID; // ID handle of the glyph texture
-  glm::ivec2 Size;        // Size of glyph
-  glm::ivec2 Bearing;     // Offset from baseline to left/top of glyph
-  unsigned int Advance;   // Offset to advance to next glyph
+  glm::ivec2 Size;      // Size of glyph
+  glm::ivec2 Bearing;   // Offset from baseline to left/top of glyph
+  unsigned int Advance; // Offset to advance to next glyph
+  glm::vec2 UVMin;      // Top-left texture coordinate in the atlas
+  glm::vec2 UVMax;      // Bottom-right texture coordinate in the atlas
+  bool Loaded;          // Metrics are known
+  int Shelf;            // Atlas shelf (-1 not resident, -2 never fits)
 };
 
 /**
  * @brief Renders text using FreeType and OpenGL.
+ *
+ * All glyphs live in a single atlas texture. Text is turned into a batch of
+ * quads (position, texture coordinate and color per vertex) so any number of
+ * strings can be drawn with one buffer upload and one draw call.
+ *
+ * The atlas stores signed distance fields rather than coverage bitmaps, so
+ * one Load serves every scale: the shader rebuilds a sharp, antialiased edge
+ * whether the text is drawn smaller or several times larger than fontSize.
+ * The fields are expensive to build and are cached on disk (AssetCache,
+ * category "fonts").
+ *
+ * Text is UTF-8. Glyphs are loaded on first use, for any codepoint the font
+ * has, into a fixed-size atlas split into equal-height shelves. When the
+ * atlas is full the least recently used shelf is evicted (never one used by
+ * the batch being built), so memory stays bounded however many characters
+ * are shown. ASCII glyphs are looked up in a flat array, the rest in a hash
+ * map.
  */
 class TextRenderer {
 public:
-  /** @brief Holds a list of pre-compiled Characters */
-  std::map<char, Character> Characters;
+  /// Number of glyphs with a direct lookup slot (ASCII)
+  static const int GLYPH_COUNT = 128;
+  /// Width and height of the atlas texture in texels
+  static const int ATLAS_SIZE = 512;
+  /// Glyphs are rasterized this many times larger than the stored field
+  static const int SDF_UPSCALE = 4;
+  /// Distance range (pixels at fontSize) encoded around each glyph edge
+  static const int SDF_SPREAD = 4;
+  /// Character::Shelf of a glyph too large for any shelf (never retried)
+  static const int UNPLACEABLE_SHELF = -2;
+
+  /// Distance field of one glyph before it is packed into the atlas
+  struct GlyphBitmap {
+    glm::ivec2 Size;                   // Field size (including the spread)
+    glm::ivec2 Bearing;                // Offset from baseline to left/top
+    unsigned int Advance;              // Advance in 1/64 pixels
+    std::vector<unsigned char> Pixels; // Size.x * Size.y distances
+  };
+
+  /** @brief ASCII glyph metrics, indexed directly by character code */
+  Character Characters[GLYPH_COUNT];
   /** @brief Shader used for text rendering */
   unsigned int TextShader;
+  /** @brief Single-channel texture holding every glyph */
+  unsigned int AtlasTexture;
 
   /**
    * @brief Construct a new Text Renderer object.
@@ -36,15 +79,26 @@ public:
   TextRenderer(unsigned int width, unsigned int height);
 
   /**
-   * @brief Pre-compiles a list of characters from the given font.
+   * @brief Frees the atlas, shader and buffers.
+   */
+  ~TextRenderer();
+
+  /**
+   * @brief Selects the font and preloads the printable ASCII glyphs.
+   *
+   * Other characters are loaded when first drawn or measured. Distance
+   * fields are read from the disk cache when the font file, size and SDF
+   * parameters match a previous run; FreeType only opens the font on a miss.
    *
    * @param font Path to the font file.
    * @param fontSize Size of the font to load.
    */
-  void Load(std::string font, unsigned int fontSize);
+  void Load(const std::string &font, unsigned int fontSize);
 
   /**
-   * @brief Renders a string of text using the precompiled list of characters.
+   * @brief Renders a string of text immediately (one draw call).
+   *
+   * Anything already queued with QueueText is drawn in the same call.
    *
    * @param text The text string to render.
    * @param x Screen X position.
@@ -52,9 +106,26 @@ public:
    * @param scale Scaling factor.
    * @param color Text color (RGB).
    */
-  void RenderText(std::string text, float x, float y, float scale,
+  void RenderText(const std::string &text, float x, float y, float scale,
                   glm::vec3 color = glm::vec3(1.0f));
 
+  /**
+   * @brief Adds a string to the pending batch without drawing it.
+   *
+   * @param text The text string to render.
+   * @param x Screen X position.
+   * @param y Screen Y position.
+   * @param scale Scaling factor.
+   * @param color Text color (RGB).
+   */
+  void QueueText(const std::string &text, float x, float y, float scale,
+                 glm::vec3 color = glm::vec3(1.0f));
+
+  /**
+   * @brief Draws every queued string with a single draw call.
+   */
+  void Flush();
+
   /**
    * @brief Calculates the width of a text string in pixels.
    *
@@ -62,11 +133,89 @@ public:
    * @param scale The scale factor to apply.
    * @return float The total width in pixels.
    */
-  float CalculateTextWidth(std::string text, float scale);
+  float CalculateTextWidth(const std::string &text, float scale);
+
+  /**
+   * @brief Shapes a string into quads and appends them to a vertex array.
+   *
+   * Used by QueueText and by TextLayout to build cached geometry. Missing
+   * glyphs are loaded into the atlas first.
+   *
+   * @param out Vertex array (FLOATS_PER_VERTEX floats per vertex).
+   * @param text The text string to shape.
+   * @param x Screen X position.
+   * @param y Screen Y position.
+   * @param scale Scaling factor.
+   * @param color Text color (RGB).
+   */
+  void AppendQuads(std::vector<float> &out, const std::string &text, float x,
+                   float y, float scale, glm::vec3 color);
+
+  /**
+   * @brief Draws vertices already stored in a buffer with the text shader.
+   *
+   * @param vao VAO configured with ConfigureVertexAttributes.
+   * @param vertexCount Number of vertices to draw.
+   */
+  void DrawVertices(unsigned int vao, int vertexCount);
+
+  /**
+   * @brief Sets the text vertex format on the currently bound VAO/VBO.
+   */
+  static void ConfigureVertexAttributes();
+
+  /**
+   * @brief Incremented whenever glyph metrics or atlas coordinates change
+   * (new font or shelf eviction).
+   *
+   * Cached geometry built with an older generation must be rebuilt.
+   */
+  unsigned int Generation() const { return generation; }
+
+  /// Floats per vertex: vec2 position, vec2 texcoord, vec3 color
+  static const int FLOATS_PER_VERTEX = 7;
 
 private:
+  /// A full-width row of the atlas
+  struct Shelf {
+    int PenX;                     // Next free x position
+    unsigned int LastUsed;        // batchStamp of the last batch using it
+    std::vector<uint32_t> Glyphs; // Codepoints placed on the shelf
+  };
+
+  static bool RasterizeGlyph(FT_Face face, unsigned long codepoint,
+                             GlyphBitmap &out);
+
+  Character &GetGlyph(uint32_t codepoint);
+  bool LoadGlyphBitmap(uint32_t codepoint, GlyphBitmap &glyph);
+  int PlaceInAtlas(uint32_t codepoint, Character &ch,
+                   const GlyphBitmap &glyph);
+  bool OpenFace();
+  void CloseFace();
+
+  /// See Generation()
+  unsigned int generation;
+
+  // Font source (FreeType is only opened when a glyph is not cached)
+  std::string fontPath;
+  unsigned int fontSize;
+  uint64_t fontKey;
+  FT_Library ft;
+  FT_Face face;
+
+  // Atlas shelves
+  std::unordered_map<uint32_t, Character> extendedGlyphs;
+  std::vector<Shelf> shelves;
+  int shelfHeight;
+  /// Identifies the batch being built; shelves it uses are never evicted
+  unsigned int batchStamp;
+
   // Render state
   unsigned int VAO, VBO;
+  /// Current size of the VBO in bytes (grown on demand)
+  size_t bufferCapacity;
+  /// Vertices waiting for the next Flush
+  std::vector<float> batch;
 };
 
 #endif
@@ -0,0 +1,104 @@
+/**
+ * @file TextureCache.h
+ * @brief Declaration of the TextureCache class - cooked textures on disk
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A texture with its whole mip chain, ready to upload as is
+ *
+ * The pixels either live in a memory-mapped cache file or, right after
+ * cooking, in memory owned by the object. Levels are tightly packed
+ * (unpack alignment 1), largest first.
+ */
+class CookedTexture {
+public:
+  /// One mip level inside Data
+  struct Level {
+    int Width, Height;
+    size_t Offset, Size;
+  };
+
+  int Width, Height;
+  /// Bytes per texel: 1 (R8), 2 (RG8), 3 (RGB8) or 4 (RGBA8)
+  int Channels;
+  std::vector<Level> Levels;
+  /// Start of the level data
+  const unsigned char *Data;
+  /// Bytes of level data (all levels)
+  size_t Size;
+
+  CookedTexture();
+  ~CookedTexture();
+  CookedTexture(CookedTexture &&other) noexcept;
+  CookedTexture &operator=(CookedTexture &&other) noexcept;
+
+  CookedTexture(const CookedTexture &) = delete;
+  CookedTexture &operator=(const CookedTexture &) = delete;
+
+  /// Unmaps or frees the pixels; the object becomes empty
+  void Release();
+
+  /// True if the texture holds pixels
+  bool Valid() const { return Data != nullptr; }
+
+  /// OpenGL sized internal format (GL_R8, GL_RGB8, ...)
+  unsigned int InternalFormat() const;
+  /// OpenGL pixel format of the level data (GL_RED, GL_RGB, ...)
+  unsigned int Format() const;
+
+private:
+  friend class TextureCache;
+
+  /// Pixels cooked in this run
+  std::vector<unsigned char> storage;
+  /// Cache file holding the pixels (closed if they are in storage)
+  MappedFile file;
+};
+
+/**
+ * @brief Converts image files into GPU-ready containers, cooked once
+ *
+ * The first time a texture is requested its image is decoded (stb_image,
+ * flipped for OpenGL), reduced to one channel if it is grey (roughness
+ * maps), and downsampled into a full mip chain with a box filter. The
+ * result is written to the "textures" category of AssetCache, keyed by
+ * the source file's path, size and modification time. Later launches map
+ * the container straight into memory: no decode and no mip generation.
+ *
+ * Container layout (little-endian):
+ *
+ *     uint32 magic, version, width, height, channels, levelCount
+ *     levelCount x { uint32 width, height; uint64 offset, size }
+ *     level data (offsets are relative to its start)
+ *
+ * Nothing here touches GL; Load is safe to call from worker threads.
+ * All methods are static, no instantiation is required.
+ */
+class TextureCache {
+public:
+  /**
+   * @brief Gets the cooked form of an image file, cooking it if needed
+   * @param path Source image file
+   * @param texture Filled with the cooked texture
+   * @return false if the source image could not be decoded
+   */
+  static bool Load(const std::string &path, CookedTexture &texture);
+
+private:
+  static bool MapCooked(const std::string &cachePath, CookedTexture &texture);
+  static bool Cook(const std::string &path, CookedTexture &texture);
+  static void WriteCooked(const std::string &cachePath,
+                          const CookedTexture &texture);
+};
+
+#endif // TEXTURE_CACHE_H
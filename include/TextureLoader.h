@@ -0,0 +1,86 @@
+/**
+ * @file TextureLoader.h
+ * @brief Declaration of the TextureLoader class - background texture loading
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include "TextureCache.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fetches cooked textures for image files on a worker pool
+ *
+ * Queue hands a file to the workers, which get its cooked form in parallel
+ * (see TextureCache: mapped from disk, or decoded and cooked on the first
+ * launch). Poll returns finished textures, in completion order, to the
+ * thread that uploads them (see TextureManager).
+ *
+ * Nothing here touches GL; every method is thread-safe.
+ */
+class TextureLoader {
+public:
+  /// Upper bound on loading threads
+  static const int MAX_WORKERS = 8;
+
+  /// Starts the workers (one per spare core, at least one)
+  TextureLoader();
+  /// Stops the workers; queued files are dropped
+  ~TextureLoader();
+
+  TextureLoader(const TextureLoader &) = delete;
+  TextureLoader &operator=(const TextureLoader &) = delete;
+
+  /**
+   * @brief Queues a file for loading
+   * @param texture Texture the image is meant for (returned by Poll)
+   * @param path Image file
+   */
+  void Queue(unsigned int texture, const std::string &path);
+
+  /**
+   * @brief Takes one finished texture
+   * @param texture Set to the texture given to Queue
+   * @param path Set to the image file
+   * @param image Set to the cooked texture (empty if the file failed)
+   * @return false if nothing has finished since the last call
+   */
+  bool Poll(unsigned int &texture, std::string &path, CookedTexture &image);
+
+  /// Blocks until every queued file has finished
+  void Wait();
+
+  /// Files queued or being loaded, not finished yet
+  int Pending();
+
+private:
+  /// One image on its way from disk to its texture
+  struct Job {
+    unsigned int texture;
+    std::string path;
+    CookedTexture image;
+  };
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  /// Signals queued jobs (and shutdown) to the workers
+  std::condition_variable jobQueued;
+  /// Signals finished jobs to Wait
+  std::condition_variable jobFinished;
+  std::deque<Job> queued, finished;
+  /// Jobs taken by a worker and not finished yet
+  int loading;
+  bool stopping;
+
+  void WorkerLoop();
+};
+
+#endif // TEXTURE_LOADER_H
@@ -0,0 +1,143 @@
+/**
+ * @file TextureManager.h
+ * @brief Declaration of the TextureManager class - texture residency
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TEXTURE_MANAGER_H
+#define TEXTURE_MANAGER_H
+
+#include "TextureCache.h"
+#include "TextureLoader.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Keeps texture memory under a budget by streaming mip levels
+ *
+ * Load creates the GL texture right away, filled with a 1x1 placeholder
+ * colour, and hands the file to a TextureLoader. Once its cooked mip chain
+ * is available, the texture is streamed in one level at a time, smallest
+ * first, through a pixel buffer object (at most UPLOAD_BUDGET bytes copied
+ * per frame). GL_TEXTURE_BASE_LEVEL follows the largest level uploaded, so
+ * a blurry version shows within a frame or two and sharpens as the larger
+ * levels land. The handle never changes.
+ *
+ * Each frame the game reports how far away each texture is used
+ * (Request). A texture needs full resolution up to FULL_DETAIL_DISTANCE;
+ * each doubling of the distance beyond it drops one more top level. If the
+ * wanted levels of all textures exceed the memory budget, top levels are
+ * dropped where they buy the least: large levels of distant or unimportant
+ * textures first. Dropped levels are freed (redefined with a zero size)
+ * and streamed back from the cooked copy, which stays mapped, when the
+ * texture comes closer or the budget allows it again.
+ *
+ * Memory is estimated from the level sizes (RGB counted as 4 bytes per
+ * texel, as drivers store it). Call every method on the render thread.
+ */
+class TextureManager {
+public:
+  /// Bytes copied into the pixel buffer per frame (about 16 MB)
+  static const size_t UPLOAD_BUDGET = 16u << 20;
+  /// Distance (world units) up to which a texture wants its full resolution
+  static constexpr float FULL_DETAIL_DISTANCE = 8.0f;
+  /// Levels at most this size (texels per side) are never dropped
+  static const int MIN_RESIDENT_SIZE = 64;
+
+  /**
+   * @brief Creates the manager (the GL context must be current)
+   * @param memoryBudget Texture memory limit in bytes (0 = unlimited)
+   */
+  explicit TextureManager(size_t memoryBudget);
+  /// Stops loading; textures are kept
+  ~TextureManager();
+
+  TextureManager(const TextureManager &) = delete;
+  TextureManager &operator=(const TextureManager &) = delete;
+
+  /**
+   * @brief Creates a texture and queues its file for loading
+   * @param path Image file
+   * @param r, g, b Placeholder colour shown until the image is uploaded
+   * (flat normal maps want 128, 128, 255)
+   * @return OpenGL texture ID, valid immediately
+   */
+  unsigned int Load(const std::string &path, unsigned char r = 128,
+                    unsigned char g = 128, unsigned char b = 128);
+
+  /**
+   * @brief Reports a use of a texture for this frame
+   *
+   * The closest use since the last Update decides the resolution.
+   * Textures without a use keep the distance of the last frame they had.
+   *
+   * @param texture Texture returned by Load (others are ignored)
+   * @param distance Distance from the camera to the nearest surface
+   * @param importance Weight against dropping levels (1 = normal)
+   */
+  void Request(unsigned int texture, float distance,
+               float importance = 1.0f);
+
+  /**
+   * @brief Takes loaded textures, applies the budget and streams levels
+   * @param byteBudget Bytes to stage this call
+   */
+  void Update(size_t byteBudget = UPLOAD_BUDGET);
+
+  /// Waits for every queued file and streams in all wanted levels
+  void Finish();
+
+  /// Textures still loading or streaming in
+  int Pending();
+
+  /// Estimated bytes of the resident levels
+  size_t ResidentBytes() const { return residentBytes; }
+
+  /// Texture memory limit in bytes (0 = unlimited)
+  size_t MemoryBudget() const { return memoryBudget; }
+
+private:
+  /// Residency of one texture
+  struct Entry {
+    std::string path;
+    /// Cooked mip chain (empty until loaded, or if loading failed)
+    CookedTexture image;
+    /// First resident level (Levels.size() while only the placeholder is)
+    int baseLevel;
+    /// First level wanted under the current distance and budget
+    int targetLevel;
+    float distance;
+    float importance;
+    /// Request was called for this texture since the last Update
+    bool requested;
+    bool loaded;
+  };
+
+  TextureLoader loader;
+  std::unordered_map<unsigned int, Entry> entries;
+  size_t memoryBudget;
+  size_t residentBytes;
+
+  unsigned int pixelBuffer;
+  /// Level being staged into the pixel buffer (0 texture = none)
+  unsigned int stagingTexture;
+  int stagingLevel;
+  size_t stagedBytes;
+
+  /// Takes the textures the loader has finished
+  void ReceiveLoaded();
+  /// Sets every target level from the distances and the budget
+  void ComputeTargets();
+  /// Frees the levels above each target
+  void DropLevels();
+  /// Picks the next level to stream in; false if every target is met
+  bool NextLevel(unsigned int &texture, int &level);
+  /// Copies up to byteBudget bytes of the staging level; true once complete
+  bool StageLevel(const Entry &entry, size_t &byteBudget);
+  /// Uploads the staged level from the pixel buffer
+  void UploadLevel(Entry &entry);
+};
+
+#endif // TEXTURE_MANAGER_H
@@ -0,0 +1,91 @@
+/**
+ * @file Trace.h
+ * @brief Scoped timing probes exported as a Chrome trace
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records timed scopes and writes them in the Chrome trace format
+ *
+ * Probes are placed with TRACE_SCOPE("name"), which times the enclosing
+ * block. Each thread writes to its own ring buffer, so recording takes no
+ * lock (only the first event of a thread registers its ring). When a ring
+ * is full the oldest events are overwritten. Flush() writes every ring to
+ * a JSON file that chrome://tracing and ui.perfetto.dev can open.
+ *
+ * Probes only exist when the build defines MAZE_ENABLE_TRACING (CMake
+ * option of the same name); otherwise the macros expand to nothing and
+ * Flush() does nothing.
+ *
+ * Event names must be string literals: only the pointer is stored.
+ */
+class Trace {
+public:
+  /// Events kept per thread (the most recent ones win)
+  static const unsigned int RING_CAPACITY = 1u << 17;
+
+  /// Current time in nanoseconds since the first call
+  static uint64_t Now();
+
+  /**
+   * @brief Adds a finished scope to the calling thread's ring
+   * @param name Event name (string literal)
+   * @param start Start time from Now()
+   * @param end End time from Now()
+   */
+  static void Record(const char *name, uint64_t start, uint64_t end);
+
+  /**
+   * @brief Names the calling thread in the trace
+   * @param name Thread name (string literal)
+   */
+  static void SetThreadName(const char *name);
+
+  /**
+   * @brief Writes every recorded event to a Chrome trace JSON file
+   *
+   * Call once threads have stopped recording (e.g. at exit).
+   *
+   * @param path Output file
+   * @return true if the file was written (always true when disabled)
+   */
+  static bool Flush(const std::string &path);
+
+  /**
+   * @brief RAII probe: records the time between construction and
+   * destruction
+   */
+  class Scope {
+  public:
+    explicit Scope(const char *name) : name(name), start(Now()) {}
+    ~Scope() { Record(name, start, Now()); }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    const char *name;
+    uint64_t start;
+  };
+};
+
+#ifdef MAZE_ENABLE_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+/// Times the rest of the enclosing block
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+/// Names the calling thread in the trace
+#define TRACE_THREAD_NAME(name) Trace::SetThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRACE_H
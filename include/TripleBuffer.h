@@ -0,0 +1,72 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Lock-free single-producer/single-consumer triple buffer
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * @brief Hands the latest value from one thread to another without locks
+ *
+ * Three slots are rotated between the writer, the reader and a shared
+ * "middle" slot. The writer fills its slot and publishes it by swapping it
+ * with the middle one; the reader swaps the middle slot with its own when a
+ * fresh value is there. Neither side ever waits: the writer can publish as
+ * often as it likes (unread values are simply replaced) and the reader keeps
+ * the last value it acquired until a newer one arrives.
+ *
+ * Exactly one thread may call Write/Publish and one thread Acquire/Read.
+ *
+ * @tparam T Value type (the writer must overwrite the whole slot, since a
+ * slot it gets back holds an old value)
+ */
+template <typename T> class TripleBuffer {
+public:
+  TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /// Slot owned by the writer
+  T &Write() { return slots[writeIndex]; }
+
+  /// Makes the writer's slot the newest value
+  void Publish() {
+    unsigned int previous =
+        middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+    writeIndex = previous & INDEX_MASK;
+  }
+
+  /**
+   * @brief Takes the newest value if one was published since the last call
+   * @return true if Read() now returns a newer value
+   */
+  bool Acquire() {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+      return false;
+    unsigned int previous =
+        middle.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & INDEX_MASK;
+    return true;
+  }
+
+  /// Slot owned by the reader (last acquired value)
+  const T &Read() const { return slots[readIndex]; }
+
+private:
+  static const unsigned int INDEX_MASK = 3;
+  static const unsigned int FRESH = 4;
+
+  T slots[3];
+  /// Index of the middle slot, with FRESH set while it is unread
+  std::atomic<unsigned int> middle;
+  unsigned int writeIndex;
+  unsigned int readIndex;
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -16,9 +16,19 @@
  * @return  void
  */
 void maze::kruskal::generate(void)
+{
+  generate(random_device());
+}
+
+/**
+ * @brief   This method generates the maze with Kruskal's algorithm.
+ * @param   seed - Seed of the generator (same seed, same maze).
+ * @return  void
+ */
+void maze::kruskal::generate(uint32_t seed)
 {
   /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
+  std::mt19937 random_generator(seed);
 
   /* Do the initialization for sets, similar way to area. */
   sets.resize(area.size());
@@ -19,6 +19,7 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(uint32_t seed);
 
     private:
       struct element {
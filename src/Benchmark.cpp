@@ -0,0 +1,202 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Implementation of the Benchmark class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/Benchmark.h"
+#include "../include/GLStateCache.h"
+#include "../include/Game.h"
+#include "../include/LaunchOptions.h"
+#include "glad/glad.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Creates an RGBA8 + depth/stencil framebuffer of the given size
+ */
+Benchmark::Benchmark(unsigned int width, unsigned int height)
+    : width(width), height(height), framebuffer(0), colorBuffer(0),
+      depthBuffer(0), valid(false) {
+  glGenFramebuffers(1, &framebuffer);
+  GLStateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+  glGenRenderbuffers(1, &colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, colorBuffer);
+
+  glGenRenderbuffers(1, &depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, depthBuffer);
+
+  valid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  if (!valid)
+    std::cerr << "ERROR: Benchmark framebuffer is incomplete" << std::endl;
+
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  GLStateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Frees the framebuffer and its attachments
+ */
+Benchmark::~Benchmark() {
+  if (framebuffer != 0)
+    GLStateCache::Get().DeleteFramebuffers(1, &framebuffer);
+  if (colorBuffer != 0)
+    glDeleteRenderbuffers(1, &colorBuffer);
+  if (depthBuffer != 0)
+    glDeleteRenderbuffers(1, &depthBuffer);
+}
+
+/**
+ * @brief Binds the offscreen framebuffer and matches the viewport to it
+ */
+void Benchmark::Bind() const {
+  GLStateCache &state = GLStateCache::Get();
+  state.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  state.Viewport(0, 0, width, height);
+}
+
+/**
+ * @brief Reads back the framebuffer and writes it as a binary PPM (P6)
+ */
+bool Benchmark::DumpFrame(const std::string &path) const {
+  std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+  FILE *file = fopen(path.c_str(), "wb");
+  if (!file) {
+    std::cerr << "ERROR: Could not write frame dump: " << path << std::endl;
+    return false;
+  }
+  fprintf(file, "P6\n%u %u\n255\n", width, height);
+
+  // OpenGL rows start at the bottom, PPM rows at the top
+  size_t rowBytes = static_cast<size_t>(width) * 3;
+  for (unsigned int row = height; row-- > 0;)
+    fwrite(&pixels[row * rowBytes], 1, rowBytes, file);
+  fclose(file);
+  return true;
+}
+
+/**
+ * @brief Prints min/avg/p50/p95/p99/max of a set of frame times
+ */
+void Benchmark::PrintStatistics(const std::string &label,
+                                std::vector<double> milliseconds) {
+  if (milliseconds.empty())
+    return;
+  std::sort(milliseconds.begin(), milliseconds.end());
+
+  double sum = 0.0;
+  for (double value : milliseconds)
+    sum += value;
+  auto percentile = [&](double p) {
+    size_t index = static_cast<size_t>(p * (milliseconds.size() - 1) + 0.5);
+    return milliseconds[index];
+  };
+
+  std::cout << std::fixed << std::setprecision(3) << label
+            << " (ms): min " << milliseconds.front() << " | avg "
+            << sum / milliseconds.size() << " | p50 " << percentile(0.50)
+            << " | p95 " << percentile(0.95) << " | p99 " << percentile(0.99)
+            << " | max " << milliseconds.back() << std::endl;
+  std::cout.unsetf(std::ios::fixed);
+}
+
+/**
+ * @brief Runs warm-up and measured frames, then prints the statistics
+ */
+int Benchmark::Run(Game &game, const LaunchOptions &options) {
+  Benchmark target(game.Width, game.Height);
+  if (!target.IsValid())
+    return -1;
+
+  bool dumping = !options.dumpDirectory.empty();
+  if (dumping) {
+    std::error_code ec;
+    std::filesystem::create_directories(options.dumpDirectory, ec);
+  }
+
+  // A replayed log drives the session instead of the scripted turn
+  bool replay = !options.replayFile.empty();
+
+  const char *renderer =
+      reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+  std::cout << "\n===== HEADLESS BENCHMARK =====" << std::endl;
+  std::cout << "Renderer: " << (renderer ? renderer : "unknown") << " | "
+            << game.Width << "x" << game.Height << " | ";
+  if (replay)
+    std::cout << "replay " << options.replayFile;
+  else
+    std::cout << options.benchmarkFrames << " frames";
+  std::cout << " (+" << WARMUP_FRAMES << " warm-up)" << std::endl;
+
+  // Skip the intro dialog so the scene is measured, not the overlay (a
+  // replay dismisses it itself)
+  if (!replay)
+    game.showingIntroDialog = false;
+
+  const float FRAME_TIME = 1.0f / 60.0f;
+  std::vector<double> submitTimes, frameTimes;
+  submitTimes.reserve(options.benchmarkFrames);
+  frameTimes.reserve(options.benchmarkFrames);
+  int totalFrames = WARMUP_FRAMES + options.benchmarkFrames;
+
+  // Every texture in place before the first frame: uploads are not measured
+  game.FinishTextureLoads();
+
+  // A replay runs until its log is exhausted
+  for (int i = 0; replay ? !game.ReplayFinished() : i < totalFrames; i++) {
+    double start = glfwGetTime();
+    glfwPollEvents();
+
+    // Scripted slow turn so the measured frames cover different views
+    if (!replay)
+      game.ProcessMouseMovement(2.0f, 0.0f);
+    float alpha = game.Advance(FRAME_TIME);
+
+    target.Bind();
+    glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Sky blue background
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    game.Render(alpha);
+
+    double submitted = glfwGetTime();
+    glFinish(); // Include GPU time in the measurement
+    double finished = glfwGetTime();
+
+    int measured = i - WARMUP_FRAMES;
+    if (measured < 0)
+      continue;
+    submitTimes.push_back((submitted - start) * 1000.0);
+    frameTimes.push_back((finished - start) * 1000.0);
+
+    if (dumping && measured % options.dumpEvery == 0) {
+      char name[32];
+      snprintf(name, sizeof(name), "/frame_%05d.ppm", measured);
+      target.DumpFrame(options.dumpDirectory + name);
+    }
+  }
+  GLStateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  PrintStatistics("CPU submit", submitTimes);
+  PrintStatistics("Frame (CPU + GPU)", frameTimes);
+
+  double total = 0.0;
+  for (double value : frameTimes)
+    total += value;
+  double fps = total > 0.0 ? frameTimes.size() * 1000.0 / total : 0.0;
+  std::cout << "Average FPS: " << fps << std::endl;
+  return 0;
+}
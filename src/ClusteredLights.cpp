@@ -0,0 +1,348 @@
+/**
+ * @file ClusteredLights.cpp
+ * @brief Implementation of the ClusteredLights class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/ClusteredLights.h"
+#include "../include/GLStateCache.h"
+#include "../include/Shader.h"
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+/// Texture units of the light buffers (after the mesh material textures)
+const int LIGHT_DATA_UNIT = 5;
+const int CLUSTER_GRID_UNIT = 6;
+const int LIGHT_INDEX_UNIT = 7;
+
+const char *VERTEX_SHADER = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec3 aNormal;
+    layout (location = 2) in vec2 aTexCoords;
+    out vec3 ViewPos;
+    out vec3 ViewNormal;
+    out vec2 TexCoords;
+    invariant gl_Position;
+    uniform mat4 model;
+    uniform mat4 view;
+    uniform mat4 projection;
+    void main() {
+        ViewPos = (view * model * vec4(aPos, 1.0)).xyz;
+        // Models only use uniform scale, so no inverse transpose is needed
+        ViewNormal = mat3(view * model) * aNormal;
+        TexCoords = aTexCoords;
+        // Same expression as the scene shaders so GL_LEQUAL sees equal depths
+        gl_Position = projection * view * model * vec4(aPos, 1.0);
+    }
+)";
+
+const char *FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec3 ViewPos;
+    in vec3 ViewNormal;
+    in vec2 TexCoords;
+    out vec4 FragColor;
+
+    uniform sampler2D texture_diffuse1;
+    uniform vec3 objectColor;
+
+    uniform samplerBuffer lightData;    // (view pos, radius), (color, 0)
+    uniform usamplerBuffer clusterGrid; // (first index, count)
+    uniform usamplerBuffer lightIndices;
+    uniform ivec3 gridSize;
+    uniform vec2 viewportOrigin;
+    uniform vec2 tileSize;
+    uniform float sliceScale;
+    uniform float sliceBias;
+
+    void main() {
+        ivec2 tile = ivec2((gl_FragCoord.xy - viewportOrigin) / tileSize);
+        tile = clamp(tile, ivec2(0), gridSize.xy - 1);
+        int slice = int(log(-ViewPos.z) * sliceScale + sliceBias);
+        slice = clamp(slice, 0, gridSize.z - 1);
+        int cluster = tile.x + gridSize.x * (tile.y + gridSize.y * slice);
+        uvec2 range = texelFetch(clusterGrid, cluster).rg;
+
+        vec3 albedo = objectColor * texture(texture_diffuse1, TexCoords).rgb;
+        vec3 N = normalize(ViewNormal);
+        vec3 V = normalize(-ViewPos);
+
+        vec3 result = vec3(0.0);
+        for (uint i = 0u; i < range.y; i++) {
+            int light = int(texelFetch(lightIndices, int(range.x + i)).r);
+            vec4 posRadius = texelFetch(lightData, light * 2);
+            vec3 toLight = posRadius.xyz - ViewPos;
+            float dist = length(toLight);
+            if (dist >= posRadius.w)
+                continue;
+            vec3 L = toLight / dist;
+            vec3 H = normalize(L + V);
+            float falloff = 1.0 - dist / posRadius.w;
+            falloff *= falloff;
+            float diffuse = max(dot(N, L), 0.0);
+            float specular = pow(max(dot(N, H), 0.0), 32.0) * 0.3;
+            vec3 color = texelFetch(lightData, light * 2 + 1).rgb;
+            result += (albedo * diffuse + specular) * color * falloff;
+        }
+        FragColor = vec4(result, 1.0);
+    }
+)";
+
+} // namespace
+
+/**
+ * @brief Creates the shader and the texture buffers
+ */
+ClusteredLights::ClusteredLights()
+    : clusterCounts(CLUSTER_COUNT), clusterRanges(CLUSTER_COUNT * 2),
+      visibleCount(0) {
+  shader = new Shader("ClusteredLights", VERTEX_SHADER, FRAGMENT_SHADER);
+
+  GLStateCache &state = GLStateCache::Get();
+  glGenBuffers(3, buffers);
+  glGenTextures(3, textures);
+  const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+  const int units[3] = {LIGHT_DATA_UNIT, CLUSTER_GRID_UNIT, LIGHT_INDEX_UNIT};
+  for (int i = 0; i < 3; i++) {
+    state.BindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+    glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+    // Each texture stays on its own unit; Begin only rebinds if it moved
+    state.BindTexture(units[i], GL_TEXTURE_BUFFER, textures[i]);
+    glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+  }
+
+  shader->use();
+  shader->setInt("lightData", LIGHT_DATA_UNIT);
+  shader->setInt("clusterGrid", CLUSTER_GRID_UNIT);
+  shader->setInt("lightIndices", LIGHT_INDEX_UNIT);
+}
+
+/**
+ * @brief Frees the shader and the texture buffers
+ */
+ClusteredLights::~ClusteredLights() {
+  GLStateCache::Get().DeleteTextures(3, textures);
+  GLStateCache::Get().DeleteBuffers(3, buffers);
+  glDeleteProgram(shader->ID);
+  delete shader;
+}
+
+void ClusteredLights::Clear() {
+  posX.clear();
+  posY.clear();
+  posZ.clear();
+  radius.clear();
+  colors.clear();
+}
+
+void ClusteredLights::AddLight(const glm::vec3 &position, float lightRadius,
+                               const glm::vec3 &color) {
+  if (static_cast<int>(posX.size()) >= MAX_LIGHTS)
+    return;
+  posX.push_back(position.x);
+  posY.push_back(position.y);
+  posZ.push_back(position.z);
+  radius.push_back(lightRadius);
+  colors.push_back(color);
+}
+
+/**
+ * @brief Conservative cluster range of a view-space sphere
+ *
+ * Depth slices come from the sphere's depth extent. Screen tiles come from
+ * projecting its bounding box: x/-z is monotonic in x and z, so the extreme
+ * corners give the extreme screen positions. Boxes crossing the near plane
+ * cover the whole screen.
+ */
+bool ClusteredLights::ClusterBounds(float x, float y, float z, float r,
+                                    const glm::mat4 &projection,
+                                    float nearPlane, float farPlane,
+                                    int bounds[6]) const {
+  float depthMin = -z - r;
+  float depthMax = -z + r;
+  if (depthMax < nearPlane || depthMin > farPlane)
+    return false;
+
+  float logRange = std::log(farPlane / nearPlane);
+  auto slice = [&](float depth) {
+    depth = std::max(depth, nearPlane);
+    int s = static_cast<int>(std::log(depth / nearPlane) / logRange * SLICES);
+    return std::max(0, std::min(SLICES - 1, s));
+  };
+  bounds[4] = slice(depthMin);
+  bounds[5] = slice(depthMax);
+
+  if (depthMin <= nearPlane) {
+    bounds[0] = 0;
+    bounds[1] = TILES_X - 1;
+    bounds[2] = 0;
+    bounds[3] = TILES_Y - 1;
+    return true;
+  }
+
+  float ndc[4] = {1e9f, -1e9f, 1e9f, -1e9f}; // min x, max x, min y, max y
+  const float xs[2] = {x - r, x + r};
+  const float ys[2] = {y - r, y + r};
+  const float depths[2] = {depthMin, depthMax};
+  for (float depth : depths) {
+    for (int i = 0; i < 2; i++) {
+      float px = projection[0][0] * xs[i] / depth;
+      float py = projection[1][1] * ys[i] / depth;
+      ndc[0] = std::min(ndc[0], px);
+      ndc[1] = std::max(ndc[1], px);
+      ndc[2] = std::min(ndc[2], py);
+      ndc[3] = std::max(ndc[3], py);
+    }
+  }
+  if (ndc[1] < -1.0f || ndc[0] > 1.0f || ndc[3] < -1.0f || ndc[2] > 1.0f)
+    return false; // Beside the frustum
+
+  auto tile = [](float value, int count) {
+    int t = static_cast<int>((value * 0.5f + 0.5f) * count);
+    return std::max(0, std::min(count - 1, t));
+  };
+  bounds[0] = tile(ndc[0], TILES_X);
+  bounds[1] = tile(ndc[1], TILES_X);
+  bounds[2] = tile(ndc[2], TILES_Y);
+  bounds[3] = tile(ndc[3], TILES_Y);
+  return true;
+}
+
+/**
+ * @brief Culls and bins the lights, uploads the buffers and sets up the
+ * additive pass
+ */
+Shader *ClusteredLights::Begin(const glm::mat4 &view,
+                               const glm::mat4 &projection, float nearPlane,
+                               float farPlane) {
+  size_t count = posX.size();
+  visibleCount = 0;
+  if (count == 0)
+    return nullptr;
+
+  // 1. View transform (structure of arrays, vectorizable)
+  viewX.resize(count);
+  viewY.resize(count);
+  viewZ.resize(count);
+  const float *m = glm::value_ptr(view);
+  for (size_t i = 0; i < count; i++) {
+    viewX[i] = m[0] * posX[i] + m[4] * posY[i] + m[8] * posZ[i] + m[12];
+    viewY[i] = m[1] * posX[i] + m[5] * posY[i] + m[9] * posZ[i] + m[13];
+    viewZ[i] = m[2] * posX[i] + m[6] * posY[i] + m[10] * posZ[i] + m[14];
+  }
+
+  // 2. Cull and count the references per cluster
+  std::fill(clusterCounts.begin(), clusterCounts.end(), 0u);
+  visibleLights.clear();
+  lightBounds.clear();
+  size_t references = 0;
+  for (size_t i = 0; i < count; i++) {
+    int bounds[6];
+    if (!ClusterBounds(viewX[i], viewY[i], viewZ[i], radius[i], projection,
+                       nearPlane, farPlane, bounds))
+      continue;
+    size_t covered = static_cast<size_t>(bounds[1] - bounds[0] + 1) *
+                     (bounds[3] - bounds[2] + 1) * (bounds[5] - bounds[4] + 1);
+    if (references + covered > MAX_LIGHT_INDICES)
+      continue; // Index list full
+    references += covered;
+
+    visibleLights.push_back(static_cast<unsigned int>(i));
+    lightBounds.insert(lightBounds.end(), bounds, bounds + 6);
+    for (int z = bounds[4]; z <= bounds[5]; z++)
+      for (int y = bounds[2]; y <= bounds[3]; y++)
+        for (int x = bounds[0]; x <= bounds[1]; x++)
+          clusterCounts[x + TILES_X * (y + TILES_Y * z)]++;
+  }
+  visibleCount = static_cast<int>(visibleLights.size());
+  if (visibleCount == 0)
+    return nullptr;
+
+  // 3. Prefix sum into (offset, count) ranges, then fill the index list
+  unsigned int offset = 0;
+  for (int c = 0; c < CLUSTER_COUNT; c++) {
+    clusterRanges[c * 2] = offset;
+    clusterRanges[c * 2 + 1] = 0;
+    offset += clusterCounts[c];
+  }
+  lightIndices.resize(references);
+  lightTexels.resize(static_cast<size_t>(visibleCount) * 8);
+  for (int v = 0; v < visibleCount; v++) {
+    unsigned int i = visibleLights[v];
+    const int *bounds = &lightBounds[v * 6];
+    for (int z = bounds[4]; z <= bounds[5]; z++) {
+      for (int y = bounds[2]; y <= bounds[3]; y++) {
+        for (int x = bounds[0]; x <= bounds[1]; x++) {
+          int cluster = x + TILES_X * (y + TILES_Y * z);
+          unsigned int *range = &clusterRanges[cluster * 2];
+          lightIndices[range[0] + range[1]++] = static_cast<unsigned int>(v);
+        }
+      }
+    }
+
+    float *texel = &lightTexels[v * 8];
+    texel[0] = viewX[i];
+    texel[1] = viewY[i];
+    texel[2] = viewZ[i];
+    texel[3] = radius[i];
+    texel[4] = colors[i].x;
+    texel[5] = colors[i].y;
+    texel[6] = colors[i].z;
+    texel[7] = 0.0f;
+  }
+
+  // 4. Upload (orphaning the previous frame's storage)
+  GLStateCache &state = GLStateCache::Get();
+  state.BindBuffer(GL_TEXTURE_BUFFER, buffers[0]);
+  glBufferData(GL_TEXTURE_BUFFER, lightTexels.size() * sizeof(float),
+               lightTexels.data(), GL_STREAM_DRAW);
+  state.BindBuffer(GL_TEXTURE_BUFFER, buffers[1]);
+  glBufferData(GL_TEXTURE_BUFFER, clusterRanges.size() * sizeof(unsigned int),
+               clusterRanges.data(), GL_STREAM_DRAW);
+  state.BindBuffer(GL_TEXTURE_BUFFER, buffers[2]);
+  glBufferData(GL_TEXTURE_BUFFER, lightIndices.size() * sizeof(unsigned int),
+               lightIndices.data(), GL_STREAM_DRAW);
+
+  const int units[3] = {LIGHT_DATA_UNIT, CLUSTER_GRID_UNIT, LIGHT_INDEX_UNIT};
+  for (int t = 0; t < 3; t++)
+    state.BindTexture(units[t], GL_TEXTURE_BUFFER, textures[t]);
+
+  // 5. Per-frame uniforms
+  GLint viewport[4];
+  state.GetViewport(viewport);
+  shader->use();
+  shader->setMat4("view", glm::value_ptr(view));
+  shader->setMat4("projection", glm::value_ptr(projection));
+  glUniform3i(glGetUniformLocation(shader->ID, "gridSize"), TILES_X, TILES_Y,
+              SLICES);
+  shader->setVec2("viewportOrigin", (float)viewport[0], (float)viewport[1]);
+  shader->setVec2("tileSize", (float)viewport[2] / TILES_X,
+                  (float)viewport[3] / TILES_Y);
+  // slice = log(depth / near) / log(far / near) * SLICES
+  float sliceScale = SLICES / std::log(farPlane / nearPlane);
+  shader->setFloat("sliceScale", sliceScale);
+  shader->setFloat("sliceBias", -std::log(nearPlane) * sliceScale);
+
+  // Add light on top of the shaded scene without touching depth
+  state.SetEnabled(GL_BLEND, true);
+  state.BlendFunc(GL_ONE, GL_ONE);
+  state.DepthFunc(GL_LEQUAL);
+  state.DepthMask(false);
+  return shader;
+}
+
+/**
+ * @brief Back to opaque rendering with depth writes
+ */
+void ClusteredLights::End() {
+  GLStateCache &state = GLStateCache::Get();
+  state.DepthMask(true);
+  state.DepthFunc(GL_LESS);
+  state.SetEnabled(GL_BLEND, false);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file DynamicResolution.cpp
+ * @brief Implementation of the DynamicResolution class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/DynamicResolution.h"
+#include "../include/GLStateCache.h"
+#include "../include/RenderStats.h"
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+DynamicResolution::DynamicResolution(float budgetMilliseconds)
+    : budget(budgetMilliseconds), scale(MAX_SCALE), framesSinceAdjust(0),
+      framebuffer(0), colorBuffer(0), depthBuffer(0), targetWidth(0),
+      targetHeight(0), previousFramebuffer(0), sceneWidth(0),
+      sceneHeight(0) {
+  for (int i = 0; i < 4; i++)
+    previousViewport[i] = 0;
+}
+
+DynamicResolution::~DynamicResolution() { Release(); }
+
+/**
+ * @brief Moves the scale when the GPU time leaves [LOWER_BAND, 1] x budget
+ */
+void DynamicResolution::Update(float gpuMilliseconds) {
+  if (++framesSinceAdjust < ADJUST_INTERVAL || gpuMilliseconds <= 0.0f)
+    return;
+  if (gpuMilliseconds <= budget && gpuMilliseconds >= budget * LOWER_BAND)
+    return; // Inside the band
+
+  // Aim for the middle of the band; pixels (scale^2) track GPU time
+  float target = budget * (1.0f + LOWER_BAND) * 0.5f;
+  float wanted = scale * std::sqrt(target / gpuMilliseconds);
+  // Limit each step so a single noisy sample cannot swing the scale
+  wanted = std::max(scale * 0.85f, std::min(scale * 1.1f, wanted));
+  scale = std::max(MIN_SCALE, std::min(MAX_SCALE, wanted));
+  framesSinceAdjust = 0;
+}
+
+/**
+ * @brief Binds the target at the scaled viewport size
+ */
+void DynamicResolution::Begin() {
+  // Answered by the state cache, no driver query
+  GLStateCache &state = GLStateCache::Get();
+  previousFramebuffer = state.DrawFramebuffer();
+  state.GetViewport(previousViewport);
+
+  int width = std::max(1, previousViewport[2]);
+  int height = std::max(1, previousViewport[3]);
+  if (width != targetWidth || height != targetHeight)
+    Allocate(width, height);
+  if (framebuffer == 0) {
+    sceneWidth = 0; // Render straight to the previous framebuffer
+    return;
+  }
+
+  sceneWidth = std::max(1, static_cast<int>(width * scale + 0.5f));
+  sceneHeight = std::max(1, static_cast<int>(height * scale + 0.5f));
+
+  state.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  state.Viewport(0, 0, sceneWidth, sceneHeight);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Blits the used part of the target over the previous viewport
+ */
+void DynamicResolution::End() {
+  if (sceneWidth == 0)
+    return;
+
+  GLStateCache &state = GLStateCache::Get();
+  state.BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+  state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+  glBlitFramebuffer(0, 0, sceneWidth, sceneHeight, previousViewport[0],
+                    previousViewport[1],
+                    previousViewport[0] + previousViewport[2],
+                    previousViewport[1] + previousViewport[3],
+                    GL_COLOR_BUFFER_BIT, GL_LINEAR);
+  RenderStats::RecordStateChange();
+
+  state.BindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+  state.Viewport(previousViewport[0], previousViewport[1], previousViewport[2],
+                 previousViewport[3]);
+}
+
+/**
+ * @brief Creates an RGBA8 + depth/stencil framebuffer of the given size
+ */
+bool DynamicResolution::Allocate(int width, int height) {
+  Release();
+  // Remembered even on failure so a bad size is not retried every frame
+  targetWidth = width;
+  targetHeight = height;
+
+  GLStateCache &state = GLStateCache::Get();
+  glGenFramebuffers(1, &framebuffer);
+  state.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+  glGenRenderbuffers(1, &colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, colorBuffer);
+
+  glGenRenderbuffers(1, &depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, depthBuffer);
+
+  bool complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  state.BindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+  if (!complete) {
+    std::cerr << "ERROR: Dynamic resolution framebuffer is incomplete"
+              << std::endl;
+    Release();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Frees the framebuffer and its attachments
+ */
+void DynamicResolution::Release() {
+  if (framebuffer != 0)
+    GLStateCache::Get().DeleteFramebuffers(1, &framebuffer);
+  if (colorBuffer != 0)
+    glDeleteRenderbuffers(1, &colorBuffer);
+  if (depthBuffer != 0)
+    glDeleteRenderbuffers(1, &depthBuffer);
+  framebuffer = colorBuffer = depthBuffer = 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file ExplorationMap.cpp
+ * @brief Implementation of the ExplorationMap class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/ExplorationMap.h"
+#include "../include/Maze.h"
+#include <cmath>
+
+/**
+ * @brief Constructs an empty exploration map
+ */
+ExplorationMap::ExplorationMap()
+    : width(0), height(0), visitedCount(0), lastCell(-1, -1) {}
+
+/**
+ * @brief Clears the map and sizes it for a maze
+ * @param w Maze width in cells
+ * @param h Maze height in cells
+ */
+void ExplorationMap::Reset(int w, int h) {
+  width = w;
+  height = h;
+  size_t cells = static_cast<size_t>(w) * static_cast<size_t>(h);
+  visited.assign((cells + 63) / 64, 0);
+  visitedCount = 0;
+  lastCell = glm::ivec2(-1, -1);
+}
+
+/**
+ * @brief Returns true if the cell has been seen
+ */
+bool ExplorationMap::IsVisited(int x, int z) const {
+  if (x < 0 || x >= width || z < 0 || z >= height)
+    return false;
+  size_t index = static_cast<size_t>(z) * width + x;
+  return (visited[index >> 6] >> (index & 63)) & 1u;
+}
+
+/**
+ * @brief Sets the bit of a cell
+ * @return true if the cell was not visited before
+ */
+bool ExplorationMap::MarkVisited(int x, int z) {
+  size_t index = static_cast<size_t>(z) * width + x;
+  uint64_t bit = uint64_t(1) << (index & 63);
+  uint64_t &word = visited[index >> 6];
+  if (word & bit)
+    return false;
+  word |= bit;
+  visitedCount++;
+  return true;
+}
+
+/**
+ * @brief Reveals the cells visible from the player's cell
+ */
+bool ExplorationMap::Update(const Maze &maze, const glm::vec2 &playerCell,
+                            std::vector<glm::ivec2> &revealed) {
+  revealed.clear();
+  if (width <= 0 || height <= 0)
+    return false;
+
+  glm::ivec2 cell((int)std::floor(playerCell.x), (int)std::floor(playerCell.y));
+  if (cell == lastCell)
+    return false;
+  lastCell = cell;
+
+  if (cell.x < 0 || cell.x >= width || cell.y < 0 || cell.y >= height)
+    return false;
+
+  if (MarkVisited(cell.x, cell.y))
+    revealed.push_back(cell);
+
+  // Cast from the cell center so the result only depends on the cell
+  glm::vec2 origin(cell.x + 0.5f, cell.y + 0.5f);
+  const float TWO_PI = 6.28318530718f;
+  for (int i = 0; i < RAY_COUNT; i++) {
+    float angle = TWO_PI * i / RAY_COUNT;
+    CastRay(maze, origin, glm::vec2(std::cos(angle), std::sin(angle)),
+            revealed);
+  }
+
+  return !revealed.empty();
+}
+
+/**
+ * @brief Walks one ray through the grid (DDA) until it hits a wall
+ */
+void ExplorationMap::CastRay(const Maze &maze, const glm::vec2 &origin,
+                             const glm::vec2 &dir,
+                             std::vector<glm::ivec2> &revealed) {
+  int x = (int)std::floor(origin.x);
+  int z = (int)std::floor(origin.y);
+
+  int stepX = dir.x > 0.0f ? 1 : -1;
+  int stepZ = dir.y > 0.0f ? 1 : -1;
+
+  // Ray length needed to cross one cell on each axis
+  float deltaX = dir.x != 0.0f ? std::fabs(1.0f / dir.x) : 1e30f;
+  float deltaZ = dir.y != 0.0f ? std::fabs(1.0f / dir.y) : 1e30f;
+
+  // Ray length to the first cell boundary on each axis
+  float sideX = (stepX > 0 ? (x + 1.0f - origin.x) : (origin.x - x)) * deltaX;
+  float sideZ = (stepZ > 0 ? (z + 1.0f - origin.y) : (origin.y - z)) * deltaZ;
+
+  for (int steps = 0; steps < MAX_RAY_CELLS; steps++) {
+    if (sideX < sideZ) {
+      sideX += deltaX;
+      x += stepX;
+    } else {
+      sideZ += deltaZ;
+      z += stepZ;
+    }
+
+    if (x < 0 || x >= width || z < 0 || z >= height)
+      return;
+
+    if (MarkVisited(x, z))
+      revealed.push_back(glm::ivec2(x, z));
+
+    // 0 = wall: it is seen, but blocks everything behind it
+    if (maze.grid[z][x] == 0)
+      return;
+  }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Implementation of the FramePacer class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/FramePacer.h"
+#include "../include/GLStateCache.h"
+#include "../include/Trace.h"
+#include "glad/glad.h"
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <thread>
+
+FramePacer::FramePacer(GLFWwindow *window, bool vsync, int fpsCap)
+    : window(window), fpsCap(fpsCap), nextDeadline(Clock::now()),
+      idle(false), presentedCache(false), minimized(false), framebuffer(0),
+      colorBuffer(0), cacheWidth(0), cacheHeight(0), cacheValid(false) {
+  glfwSwapInterval(vsync ? 1 : 0);
+  std::cout << "Frame pacing: vsync " << (vsync ? "on" : "off") << ", cap ";
+  if (fpsCap > 0)
+    std::cout << fpsCap << " FPS" << std::endl;
+  else
+    std::cout << "none" << std::endl;
+}
+
+FramePacer::~FramePacer() { ReleaseCache(); }
+
+void FramePacer::PollEvents() {
+  if (idle)
+    glfwWaitEventsTimeout(IDLE_TIMEOUT);
+  else
+    glfwPollEvents();
+}
+
+/**
+ * @brief Decides between rendering and re-presenting the cached frame
+ */
+bool FramePacer::BeginFrame(bool sceneIdle) {
+  bool unfocused = glfwGetWindowAttrib(window, GLFW_FOCUSED) == GLFW_FALSE ||
+                   glfwGetWindowAttrib(window, GLFW_ICONIFIED) == GLFW_TRUE;
+  idle = sceneIdle || unfocused;
+  presentedCache = false;
+
+  int width, height;
+  glfwGetFramebufferSize(window, &width, &height);
+  minimized = width == 0 || height == 0;
+  if (!idle) {
+    cacheValid = false; // The scene moves again; the copy is outdated
+    return !minimized;
+  }
+  if (minimized)
+    return false; // Nothing visible to draw
+
+  if (cacheValid && width == cacheWidth && height == cacheHeight) {
+    GLStateCache &state = GLStateCache::Get();
+    state.BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    presentedCache = true;
+    return false;
+  }
+  return true;
+}
+
+void FramePacer::EndFrame() {
+  if (!minimized) {
+    if (idle && !presentedCache)
+      StoreFrame();
+    glfwSwapBuffers(window);
+  }
+  WaitForDeadline();
+}
+
+/**
+ * @brief Copies the back buffer of the window into the cache
+ */
+void FramePacer::StoreFrame() {
+  GLStateCache &state = GLStateCache::Get();
+  int width, height;
+  glfwGetFramebufferSize(window, &width, &height);
+  if (width != cacheWidth || height != cacheHeight) {
+    ReleaseCache();
+    // Remembered even on failure so a bad size is not retried every frame
+    cacheWidth = width;
+    cacheHeight = height;
+
+    glGenFramebuffers(1, &framebuffer);
+    state.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, colorBuffer);
+    bool complete =
+        glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+      std::cerr << "ERROR: Idle frame cache framebuffer is incomplete"
+                << std::endl;
+      ReleaseCache();
+      return;
+    }
+  }
+  if (framebuffer == 0)
+    return;
+
+  state.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+  state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+  glBlitFramebuffer(0, 0, width, height, 0, 0, width, height,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+  cacheValid = true;
+}
+
+void FramePacer::ReleaseCache() {
+  if (framebuffer != 0)
+    GLStateCache::Get().DeleteFramebuffers(1, &framebuffer);
+  if (colorBuffer != 0)
+    glDeleteRenderbuffers(1, &colorBuffer);
+  framebuffer = colorBuffer = 0;
+  cacheValid = false;
+}
+
+/**
+ * @brief Hybrid wait: sleep most of the remaining time, spin the rest
+ */
+void FramePacer::WaitForDeadline() {
+  if (fpsCap <= 0)
+    return;
+  TRACE_SCOPE("FramePacer::Wait");
+
+  const Clock::duration period =
+      std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1.0 / fpsCap));
+  const Clock::duration spin =
+      std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(SPIN_MARGIN));
+
+  Clock::time_point now = Clock::now();
+  nextDeadline += period;
+  if (nextDeadline < now) {
+    // Late frame: restart the schedule instead of rushing to catch up
+    nextDeadline = now;
+    return;
+  }
+
+  if (nextDeadline - now > spin)
+    std::this_thread::sleep_for(nextDeadline - now - spin);
+  while (Clock::now() < nextDeadline) {
+    // Spin: a sleep this short would overshoot the deadline
+  }
+}
@@ -7,18 +7,35 @@
  */
 
 #include "../include/Game.h"
+#include "../include/AssetCache.h"
+#include "../include/ClusteredLights.h"
+#include "../include/DynamicResolution.h"
+#include "../include/ExplorationMap.h"
+#include "../include/GLStateCache.h"
+#include "../include/InputRecorder.h"
+#include "../include/LaunchOptions.h"
+#include "../include/MeshCache.h"
+#include "../include/MinimapPyramid.h"
 #include "../include/Network.h"
+#include "../include/PerfHud.h"
+#include "../include/RenderQueue.h"
+#include "../include/RenderStats.h"
 #include "../include/Shader.h"
+#include "../include/ShaderCache.h"
+#include "../include/ShaderVariants.h"
+#include "../include/TextLayout.h"
 #include "../include/TextRenderer.h"
+#include "../include/TextureManager.h"
+#include "../include/Trace.h"
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
+#include <random>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #define STB_IMAGE_IMPLEMENTATION
-#define TINYOBJLOADER_IMPLEMENTATION
 #include "../include/Texture.h"
 #include "../include/stb_image.h"
-#include "../include/tiny_obj_loader.h"
 #include <iostream>
 #include <sys/select.h>
 // Filesystem helper to build paths relative to project/executable
@@ -30,9 +47,13 @@ const int PORT = 8080;          ///< Server port for host/client communication
 const char *HOST = "127.0.0.1"; ///< Localhost IP for client connection
 
 // Global rendering resources (shared across game instances)
-Shader *gameShader; ///< Main shader program for 3D rendering
-Mesh *wall_mesh;    ///< Mesh for maze walls
-Mesh *floor_mesh;   ///< Mesh for maze floor
+ShaderVariants *sceneShaders; ///< Main 3D shader, one program per variant
+Mesh *wall_mesh;              ///< Mesh for maze walls
+Mesh *floor_mesh;             ///< Mesh for maze floor
+
+// Scene shader features (bits of a ShaderVariants mask)
+const unsigned int VARIANT_TEXTURED = 1u << 0; ///< useTexture
+const unsigned int VARIANT_PORTAL = 1u << 1;   ///< isPortal
 
 // Maze size
 const int maze_heigth = 15;
@@ -40,13 +61,6 @@ const int maze_width = 15;
 
 // Functions
 
-/**
- * Loads a texture from the specified file path
- * @param path File path to the texture image
- * @return OpenGL texture ID
- */
-unsigned int loadTexture(char const *path);
-
 /**
  * Game Constructor
  * Initializes all game state variables and resources
@@ -56,19 +70,32 @@ unsigned int loadTexture(char const *path);
  * @param hostIP IP address of the host for client connections
  */
 Game::Game(unsigned int width, unsigned int height, GameMode gameMode, const std::string &hostIP)
-    : Width(width), Height(height), currentMaze(nullptr), camera(nullptr),
-      outdoorGroundMesh(nullptr), treeMesh(nullptr), gateMesh(nullptr),
+    : Width(width), Height(height), mazeSeed(std::random_device()()),
+      currentMaze(nullptr), camera(nullptr), outdoorGroundMesh(nullptr),
+      treeMesh(nullptr), gateMesh(nullptr),
       networkSocket(-1), connectedToPortal(false), portalPosition(0.0f),
       isPaused(false), windowPtr(nullptr), mode(gameMode),
       movementLocked(gameMode == GameMode::CLIENT), serverSocket(-1),
       clientSocket(-1), showingIntroDialog(true), textRenderer(nullptr),
-      inheritedColorTint(1.0f, 1.0f, 1.0f), hostIP(hostIP), overlayShaderProgram(0),
+      inheritedColorTint(1.0f, 1.0f, 1.0f), hostIP(hostIP),
+      clusteredLights(nullptr), renderQueue(nullptr), sceneBudget(0.0f),
+      textureBudget(0), depthPrepass(false),
+      simulationAccumulator(0.0f), previousCameraPosition(0.0f),
+      simulationRunning(false), pendingMouseX(0.0f), pendingMouseY(0.0f),
+      requestedCursorMode(-1), requestedFullscreenToggles(0),
+      inputRecorder(nullptr), replayFinished(false), overlayShaderProgram(0),
       overlayVAO(0), overlayVBO(0), overlayResourcesInitialized(false),
-      minimapVAO(0), minimapVBO(0), simpleShader(nullptr) {
+      introLayout(nullptr), pauseLayout(nullptr), minimapVAO(0),
+      minimapVBO(0), simpleShader(nullptr),
+      minimapPyramid(nullptr), explorationMap(nullptr),
+      minimapViewCells(64.0f), perfHud(nullptr), textureManager(nullptr),
+      texturesLoading(false), showPerfHud(false), dynamicResolution(nullptr) {
 
   // Initialize all keyboard keys to unpressed state
-  for (int i = 0; i < 1024; i++)
+  for (int i = 0; i < 1024; i++) {
     Keys[i] = false;
+    tickKeys[i] = false;
+  }
 }
 
 /**
@@ -77,22 +104,35 @@ Game::Game(unsigned int width, unsigned int height, GameMode gameMode, const std
  * shaders, and network connections
  */
 Game::~Game() {
+  // The simulation thread uses everything below
+  StopSimulationThread();
+
   // Free game objects
   delete currentMaze;
   delete camera;
-  delete gameShader;
+  delete sceneShaders;
   delete wall_mesh;
   delete floor_mesh;
   delete outdoorGroundMesh;
   delete treeMesh;
   delete gateMesh;
+  delete introLayout;
+  delete pauseLayout;
   delete textRenderer;
+  delete perfHud;
+  delete dynamicResolution;
+  delete clusteredLights;
+  delete renderQueue;
   delete simpleShader;
+  delete minimapPyramid;
+  delete explorationMap;
+  delete textureManager;
+  delete inputRecorder; // Closes the recorded log
 
   if (minimapVAO != 0)
-    glDeleteVertexArrays(1, &minimapVAO);
+    GLStateCache::Get().DeleteVertexArrays(1, &minimapVAO);
   if (minimapVBO != 0)
-    glDeleteBuffers(1, &minimapVBO);
+    GLStateCache::Get().DeleteBuffers(1, &minimapVBO);
 
   // Clean up OpenGL overlay resources (VAO, VBO, shader)
   CleanupOverlayResources();
@@ -109,6 +149,32 @@ Game::~Game() {
   }
 }
 
+// INPUT RECORD / REPLAY
+
+/**
+ * Configure Input Log
+ * Creates the input recorder when --record or --replay is given and fixes
+ * the maze seed (from the log, --seed, or random)
+ * @param options Parsed command line
+ * @return false if the log could not be opened
+ */
+bool Game::ConfigureInputLog(const LaunchOptions &options) {
+  if (options.seedProvided)
+    mazeSeed = options.mazeSeed;
+
+  if (!options.replayFile.empty()) {
+    inputRecorder = new InputRecorder();
+    if (!inputRecorder->StartReplay(options.replayFile))
+      return false;
+    mazeSeed = inputRecorder->Seed(); // Same maze as the recording
+  } else if (!options.recordFile.empty()) {
+    inputRecorder = new InputRecorder();
+    if (!inputRecorder->StartRecording(options.recordFile, mazeSeed))
+      return false;
+  }
+  return true;
+}
+
 // GAME INITIALIZATION
 
 /**
@@ -117,6 +183,12 @@ Game::~Game() {
  * generates the maze, and prepares the game for rendering
  */
 void Game::Init() {
+  TRACE_SCOPE("Game::Init");
+
+  // Preprocessed assets (shader binaries, font distance fields, ...) are
+  // cached next to them
+  AssetCache::Root() = FileSystem::getPath("cache");
+
   // Setup the network settings based on the game mode (host or client)
 
   // if its a host, we need to create a socket
@@ -189,13 +261,21 @@ void Game::Init() {
   camera = new Camera(glm::vec3(15.0f, 20.0f, 15.0f),
                       glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, -89.0f);
 
-  // Shaders setup
-  gameShader =
-      new Shader(FileSystem::getPath("shaders/blinn_phong.vert").c_str(),
-                 FileSystem::getPath("shaders/blinn_phong.frag").c_str());
-  std::cout << "Shader Program ID: " << gameShader->ID << std::endl;
-  gameShader->use();
-  gameShader->setInt("texture1", 0);
+  // Shaders setup: the useTexture/isPortal branches are compiled out per
+  // variant instead of being switched with uniforms between draws
+  sceneShaders =
+      new ShaderVariants(FileSystem::getPath("shaders/blinn_phong.vert"),
+                         FileSystem::getPath("shaders/blinn_phong.frag"),
+                         {{"useTexture", "USE_TEXTURE"},
+                          {"isPortal", "IS_PORTAL"}});
+  // Build the variants the scene uses now rather than on the first frame
+  for (unsigned int variant : {VARIANT_TEXTURED, VARIANT_PORTAL}) {
+    Shader &shader = sceneShaders->Get(variant);
+    std::cout << "Shader Program ID (variant " << variant
+              << "): " << shader.ID << std::endl;
+    shader.use();
+    shader.setInt("texture1", 0);
+  }
 
   // Walls
   // Define a unit cube (positions, normals, texture coords) used as the
@@ -254,34 +334,35 @@ void Game::Init() {
       {{-0.5f, 0.0f, 0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
       {{-0.5f, 0.0f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}};
 
-  // Load Textures
+  // Load Textures (cooked on worker threads, streamed in over the next
+  // frames; flat placeholders show until then)
+  textureManager = new TextureManager(textureBudget);
   // Walls use Bricks101 textures
-  unsigned int wallTex = loadTexture(
+  unsigned int wallTex = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_Color.png")
-          .c_str());
-  unsigned int wallNormal = loadTexture(
+          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_Color.png"));
+  unsigned int wallNormal = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_NormalGL.png")
-          .c_str());
-  unsigned int wallRoughness = loadTexture(
+          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_NormalGL.png"),
+      128, 128, 255);
+  unsigned int wallRoughness = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_Roughness.png")
-          .c_str());
+          "assets/textures/Bricks101_4K-PNG/Bricks101_4K-PNG_Roughness.png"));
 
   // Floor uses PavingStones138 textures
   unsigned int floorTex =
-      loadTexture(FileSystem::getPath("assets/textures/PavingStones138_4K-PNG/"
-                                      "PavingStones138_4K-PNG_Color.png")
-                      .c_str());
+      textureManager->Load(FileSystem::getPath(
+          "assets/textures/PavingStones138_4K-PNG/"
+          "PavingStones138_4K-PNG_Color.png"));
   unsigned int floorNormal =
-      loadTexture(FileSystem::getPath("assets/textures/PavingStones138_4K-PNG/"
-                                      "PavingStones138_4K-PNG_NormalGL.png")
-                      .c_str());
+      textureManager->Load(FileSystem::getPath(
+          "assets/textures/PavingStones138_4K-PNG/"
+          "PavingStones138_4K-PNG_NormalGL.png"),
+      128, 128, 255);
   unsigned int floorRoughness =
-      loadTexture(FileSystem::getPath("assets/textures/PavingStones138_4K-PNG/"
-                                      "PavingStones138_4K-PNG_Roughness.png")
-                      .c_str());
+      textureManager->Load(FileSystem::getPath(
+          "assets/textures/PavingStones138_4K-PNG/"
+          "PavingStones138_4K-PNG_Roughness.png"));
 
   // Create Texture structs for walls (Bricks)
   Texture wallTextureStruct;
@@ -342,7 +423,19 @@ void Game::Init() {
   currentMaze = new Maze(wall_mesh, floor_mesh);
 
   // generate with a defined width and heigth
-  currentMaze->Generate(maze_width, maze_heigth);
+  currentMaze->Generate(maze_width, maze_heigth, mazeSeed);
+
+  // Torches on every other junction cell (odd coordinates are the cells
+  // Kruskal connects), hanging just below the wall tops
+  torchPositions.clear();
+  for (int z = 1; z < currentMaze->height; z += 2) {
+    for (int x = 1; x < currentMaze->width; x += 2) {
+      if (currentMaze->grid[z][x] != 0 && (x / 2 + z / 2) % 2 == 0) {
+        torchPositions.push_back(glm::vec3(x * currentMaze->cellSize, 0.8f,
+                                           z * currentMaze->cellSize));
+      }
+    }
+  }
 
   // Find valid start position
   glm::vec3 startPos = currentMaze->FindStartPosition();
@@ -350,21 +443,20 @@ void Game::Init() {
   // delete current camera and set it up in newly found start position
   delete camera;
   camera = new Camera(startPos, glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, 0.0f);
+  previousCameraPosition = startPos; // No interpolation from the old camera
 
   // Outdoor Environment
   // Create grass texture for outdoor ground
-  unsigned int grassTex = loadTexture(
+  unsigned int grassTex = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_Color.png")
-          .c_str());
-  unsigned int grassNormal = loadTexture(
+          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_Color.png"));
+  unsigned int grassNormal = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_NormalGL.png")
-          .c_str());
-  unsigned int grassRoughness = loadTexture(
+          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_NormalGL.png"),
+      128, 128, 255);
+  unsigned int grassRoughness = textureManager->Load(
       FileSystem::getPath(
-          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_Roughness.png")
-          .c_str());
+          "assets/textures/Grass005_4K-PNG/Grass005_4K-PNG_Roughness.png"));
 
   Texture grassTextureStruct;
   grassTextureStruct.id = grassTex;
@@ -418,115 +510,19 @@ void Game::Init() {
 
   outdoorGroundMesh = new Mesh(outdoorGroundVertices, {}, grassTextures);
 
-  // Load Tree OBJ Model using tinyobjloader
-  std::cout << "Loading tree model from OBJ..." << std::endl;
-
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string warn, err;
-
+  // Tree model: cooked once from the OBJ (indexed, centred, scaled down),
+  // then mapped from the cache on later launches
   std::string objPath =
       FileSystem::getPath("assets/models/Tree_Spooky2/Tree_Spooky2_Low.obj");
-  bool loaded = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-                                 objPath.c_str());
-
-  if (!warn.empty()) {
-    std::cout << "TinyOBJ Warning: " << warn << std::endl;
-  }
-  if (!err.empty()) {
-    std::cerr << "TinyOBJ Error: " << err << std::endl;
-  }
-
-  std::vector<Vertex> treeVertices;
-  if (loaded && !shapes.empty()) {
-    // Process all shapes and combine into single vertex buffer
-    for (const auto &shape : shapes) {
-      size_t index_offset = 0;
-
-      // Iterate through all faces
-      for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
-        size_t fv = shape.mesh.num_face_vertices[f];
-
-        // Process each vertex in the face (usually 3 for triangles)
-        for (size_t v = 0; v < fv; v++) {
-          tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
-
-          Vertex vertex;
-
-          // Position
-          vertex.Position.x = attrib.vertices[3 * idx.vertex_index + 0];
-          vertex.Position.y = attrib.vertices[3 * idx.vertex_index + 1];
-          vertex.Position.z = attrib.vertices[3 * idx.vertex_index + 2];
-
-          // Normal (if available)
-          if (idx.normal_index >= 0) {
-            vertex.Normal.x = attrib.normals[3 * idx.normal_index + 0];
-            vertex.Normal.y = attrib.normals[3 * idx.normal_index + 1];
-            vertex.Normal.z = attrib.normals[3 * idx.normal_index + 2];
-          } else {
-            vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
-          }
-
-          // Texture coordinates (if available)
-          if (idx.texcoord_index >= 0) {
-            vertex.TexCoords.x = attrib.texcoords[2 * idx.texcoord_index + 0];
-            vertex.TexCoords.y = attrib.texcoords[2 * idx.texcoord_index + 1];
-          } else {
-            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-          }
-
-          treeVertices.push_back(vertex);
-        }
-        index_offset += fv;
-      }
-    }
-
-    // Now center and scale the model
-    if (!treeVertices.empty()) {
-      // Calculate bounding box
-      float minY = 10000.0f;
-      float minX = 10000.0f, maxX = -10000.0f;
-      float minZ = 10000.0f, maxZ = -10000.0f;
-
-      for (const auto &v : treeVertices) {
-        if (v.Position.y < minY)
-          minY = v.Position.y;
-        if (v.Position.x < minX)
-          minX = v.Position.x;
-        if (v.Position.x > maxX)
-          maxX = v.Position.x;
-        if (v.Position.z < minZ)
-          minZ = v.Position.z;
-        if (v.Position.z > maxZ)
-          maxZ = v.Position.z;
-      }
-
-      float centerX = (minX + maxX) / 2.0f;
-      float centerZ = (minZ + maxZ) / 2.0f;
-      float scaleFactor = 0.1f; // Scale down the model
-
-      // Center and scale all vertices
-      for (auto &v : treeVertices) {
-        float px = (v.Position.x - centerX) * scaleFactor;
-        float py = (v.Position.y - minY) * scaleFactor;
-        float pz = (v.Position.z - centerZ) * scaleFactor;
-        v.Position = glm::vec3(px, py, pz);
-      }
-
-      std::cout << "Tree model processed. Vertices: " << treeVertices.size()
-                << std::endl;
-    }
-  } else {
+  CookedMesh treeModel;
+  if (!MeshCache::LoadObj(objPath, 0.1f, treeModel))
     std::cerr << "FAILED to load Tree model!" << std::endl;
-  }
 
   std::vector<Texture> treeTextures;
   // Load tree texture
-  unsigned int treeTex = loadTexture(
+  unsigned int treeTex = textureManager->Load(
       FileSystem::getPath(
-          "assets/models/TreeSpooky2_Textures/TreeSpooky2_Color.png")
-          .c_str());
+          "assets/models/TreeSpooky2_Textures/TreeSpooky2_Color.png"));
   Texture treeTextureStruct;
   treeTextureStruct.id = treeTex;
   treeTextureStruct.type = "texture_diffuse";
@@ -534,7 +530,12 @@ void Game::Init() {
       "assets/models/TreeSpooky2_Textures/TreeSpooky2_Color.png");
   treeTextures.push_back(treeTextureStruct);
 
-  treeMesh = new Mesh(treeVertices, {}, treeTextures);
+  if (treeModel.Valid()) {
+    treeMesh = new Mesh(treeModel.Vertices, treeModel.VertexCount,
+                        treeModel.Indices, treeModel.IndexCount, treeTextures);
+    std::cout << "Tree model ready. Vertices: " << treeModel.VertexCount
+              << ", indices: " << treeModel.IndexCount << std::endl;
+  }
 
   // Position trees around the perimeter of the outdoor area
   float treeSpacing = 10.0f;
@@ -663,6 +664,13 @@ void Game::Init() {
               << std::endl;
   }
 
+  // Performance HUD (hidden until F3)
+  perfHud = new PerfHud();
+  if (sceneBudget > 0.0f)
+    dynamicResolution = new DynamicResolution(sceneBudget);
+  clusteredLights = new ClusteredLights();
+  renderQueue = new RenderQueue();
+
   // Initialize Minimap Resources
   simpleShader = new Shader(FileSystem::getPath("shaders/simple.vert").c_str(),
                             FileSystem::getPath("shaders/simple.frag").c_str());
@@ -674,66 +682,47 @@ void Game::Init() {
 
   glGenVertexArrays(1, &minimapVAO);
   glGenBuffers(1, &minimapVBO);
-  glBindVertexArray(minimapVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, minimapVBO);
+  GLStateCache::Get().BindVertexArray(minimapVAO);
+  GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, minimapVBO);
   glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices,
                GL_STATIC_DRAW);
   glEnableVertexAttribArray(0);
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-  glBindVertexArray(0);
+  GLStateCache::Get().BindVertexArray(0);
+
+  // Build the minimap pyramid (tiles are streamed to the GPU on demand)
+  minimapPyramid = new MinimapPyramid();
+  minimapPyramid->Build(*currentMaze);
+  minimapViewCells = std::min(
+      64.0f, (float)std::max(currentMaze->width, currentMaze->height));
+
+  // Fog of war: the first Render reveals the surroundings of the start cell
+  explorationMap = new ExplorationMap();
+  explorationMap->Reset(currentMaze->width, currentMaze->height);
+
+  // First snapshot, so there is something to render before the first tick
+  previousCameraPosition = camera->Position;
+  PublishSnapshot();
+  snapshots.Acquire();
 }
 
 /**
- * Load Texture Helper Function
- * Loads an image file and creates an OpenGL texture with mipmaps
- * @param path File path to the texture image
- * @return OpenGL texture ID
+ * Reveal the cells visible from the player's current cell
+ * Ray casting only happens when the player changes cell, and only the newly
+ * seen cells are pushed to the minimap pyramid. Runs on the render thread
+ * (the fog of war is purely visual) from the rendered camera position.
  */
-unsigned int loadTexture(char const *path) {
-  unsigned int textureID;
-  glGenTextures(1, &textureID);
-
-  // Flip texture vertically to match OpenGL's coordinate system
-  stbi_set_flip_vertically_on_load(true);
-
-  // Load image data
-  int width, height, nrComponents;
-  unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-
-  if (data) {
-    std::cout << "Texture Loaded! Path: " << path << " | W: " << width
-              << " H: " << height << " Ch: " << nrComponents << std::endl;
-
-    // Determine texture format based on number of color channels
-    GLenum format;
-    if (nrComponents == 1)
-      format = GL_RED; // Grayscale
-    else if (nrComponents == 3)
-      format = GL_RGB; // RGB
-    else if (nrComponents == 4)
-      format = GL_RGBA; // RGBA (with alpha)
-
-    // Upload texture to GPU
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format,
-                 GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(
-        GL_TEXTURE_2D); // Generate mipmap levels for better quality
-
-    // Set texture wrapping and filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    GL_LINEAR_MIPMAP_LINEAR); // Trilinear filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    stbi_image_free(data);
-  } else {
-    std::cout << "Texture failed to load at path: " << path << std::endl;
-    stbi_image_free(data);
-  }
+void Game::UpdateExploration() {
+  if (!explorationMap || !minimapPyramid || !currentMaze)
+    return;
 
-  return textureID;
+  glm::vec2 playerCell(renderCamera.Position.x / currentMaze->cellSize + 0.5f,
+                       renderCamera.Position.z / currentMaze->cellSize + 0.5f);
+
+  std::vector<glm::ivec2> revealed;
+  if (explorationMap->Update(*currentMaze, playerCell, revealed)) {
+    minimapPyramid->Reveal(revealed);
+  }
 }
 
 /**
@@ -795,7 +784,8 @@ void Game::ProcessInput(float dt) {
 
   // Track ENTER key state to detect single press (not hold)
   static bool enterPressedLastFrame = false;
-  bool enterPressed = Keys[GLFW_KEY_ENTER] || Keys[GLFW_KEY_KP_ENTER];
+  bool enterPressed =
+      tickKeys[GLFW_KEY_ENTER] || tickKeys[GLFW_KEY_KP_ENTER];
 
   if (showingIntroDialog) {
     // Dismiss intro dialog when ENTER is pressed
@@ -810,7 +800,7 @@ void Game::ProcessInput(float dt) {
 
   // PAUSE/UNPAUSE HANDLING (ESC key)
   static bool escPressedLastFrame = false;
-  bool escPressed = Keys[GLFW_KEY_ESCAPE];
+  bool escPressed = tickKeys[GLFW_KEY_ESCAPE];
 
   if (escPressed && !escPressedLastFrame && windowPtr) {
     // Toggle pause
@@ -818,11 +808,11 @@ void Game::ProcessInput(float dt) {
 
     if (isPaused) {
       // Show cursor
-      glfwSetInputMode(windowPtr, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+      requestedCursorMode = GLFW_CURSOR_NORMAL;
       std::cout << "Game PAUSED. Press ESC to resume." << std::endl;
     } else {
       // Hide cursor
-      glfwSetInputMode(windowPtr, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+      requestedCursorMode = GLFW_CURSOR_DISABLED;
       std::cout << "Game RESUMED." << std::endl;
     }
   }
@@ -830,26 +820,49 @@ void Game::ProcessInput(float dt) {
 
   // FULLSCREEN TOGGLE (F key)
   static bool fPressedLastFrame = false;
-  bool fPressed = Keys[GLFW_KEY_F];
+  bool fPressed = tickKeys[GLFW_KEY_F];
 
   if (fPressed && !fPressedLastFrame && windowPtr) {
-    GLFWmonitor *monitor = glfwGetWindowMonitor(windowPtr);
-
-    if (monitor == nullptr) {
-      // Currently in windowed mode - switch to fullscreen
-      GLFWmonitor *primaryMonitor = glfwGetPrimaryMonitor();
-      const GLFWvidmode *mode = glfwGetVideoMode(primaryMonitor);
-      glfwSetWindowMonitor(windowPtr, primaryMonitor, 0, 0, mode->width,
-                           mode->height, mode->refreshRate);
-      std::cout << "Switched to FULLSCREEN mode" << std::endl;
-    } else {
-      // Currently in fullscreen - switch to windowed mode
-      glfwSetWindowMonitor(windowPtr, nullptr, 100, 100, Width, Height, 0);
-      std::cout << "Switched to WINDOWED mode" << std::endl;
-    }
+    // Applied on the main thread (see ApplyWindowRequests)
+    requestedFullscreenToggles++;
   }
   fPressedLastFrame = fPressed;
 
+  // PERFORMANCE HUD TOGGLE (F3 key)
+  static bool f3PressedLastFrame = false;
+  bool f3Pressed = tickKeys[GLFW_KEY_F3];
+  if (f3Pressed && !f3PressedLastFrame)
+    showPerfHud = !showPerfHud;
+  f3PressedLastFrame = f3Pressed;
+
+  // DEPTH PRE-PASS TOGGLE (F4 key)
+  static bool f4PressedLastFrame = false;
+  bool f4Pressed = tickKeys[GLFW_KEY_F4];
+  if (f4Pressed && !f4PressedLastFrame) {
+    depthPrepass = !depthPrepass;
+    std::cout << "Depth pre-pass " << (depthPrepass ? "ON" : "OFF")
+              << std::endl;
+  }
+  f4PressedLastFrame = f4Pressed;
+
+  // MINIMAP ZOOM (+ / - keys)
+  static bool zoomInPressedLastFrame = false;
+  static bool zoomOutPressedLastFrame = false;
+  bool zoomInPressed = tickKeys[GLFW_KEY_EQUAL] || tickKeys[GLFW_KEY_KP_ADD];
+  bool zoomOutPressed =
+      tickKeys[GLFW_KEY_MINUS] || tickKeys[GLFW_KEY_KP_SUBTRACT];
+
+  if (currentMaze) {
+    float maxViewCells =
+        (float)std::max(currentMaze->width, currentMaze->height);
+    if (zoomInPressed && !zoomInPressedLastFrame)
+      minimapViewCells = std::max(8.0f, minimapViewCells * 0.5f);
+    if (zoomOutPressed && !zoomOutPressedLastFrame)
+      minimapViewCells = std::min(maxViewCells, minimapViewCells * 2.0f);
+  }
+  zoomInPressedLastFrame = zoomInPressed;
+  zoomOutPressedLastFrame = zoomOutPressed;
+
   // MOVEMENT RESTRICTIONS
 
   // Don't process movement if game is paused
@@ -881,16 +894,16 @@ void Game::ProcessInput(float dt) {
   glm::vec3 proposedMove = glm::vec3(0.0f);
 
   // W or UP Arrow: Move forward
-  if (Keys[GLFW_KEY_W] || Keys[GLFW_KEY_UP])
+  if (tickKeys[GLFW_KEY_W] || tickKeys[GLFW_KEY_UP])
     proposedMove += front * velocity;
   // S or DOWN Arrow: Move backward
-  if (Keys[GLFW_KEY_S] || Keys[GLFW_KEY_DOWN])
+  if (tickKeys[GLFW_KEY_S] || tickKeys[GLFW_KEY_DOWN])
     proposedMove -= front * velocity;
   // A or LEFT Arrow: Strafe left
-  if (Keys[GLFW_KEY_A] || Keys[GLFW_KEY_LEFT])
+  if (tickKeys[GLFW_KEY_A] || tickKeys[GLFW_KEY_LEFT])
     proposedMove -= right * velocity;
   // D or RIGHT Arrow: Strafe right
-  if (Keys[GLFW_KEY_D] || Keys[GLFW_KEY_RIGHT])
+  if (tickKeys[GLFW_KEY_D] || tickKeys[GLFW_KEY_RIGHT])
     proposedMove += right * velocity;
 
   // Apply movement with collision detection (X and Z axes independently)
@@ -916,19 +929,18 @@ void Game::ProcessInput(float dt) {
 
 /**
  * Process Mouse Movement
- * Updates camera orientation based on mouse movement (look around)
+ * Queues mouse movement for the next simulation tick (look around)
  * @param xoffset Horizontal mouse movement
  * @param yoffset Vertical mouse movement
- * @param constrainPitch Prevent camera from flipping upside down
  */
-void Game::ProcessMouseMovement(float xoffset, float yoffset,
-                                bool constrainPitch) {
-  // Ignore mouse input when game is paused
-  if (isPaused) {
-    return;
+void Game::ProcessMouseMovement(float xoffset, float yoffset) {
+  // Accumulate until the next tick (no atomic fetch_add for float in C++17)
+  float x = pendingMouseX.load();
+  while (!pendingMouseX.compare_exchange_weak(x, x + xoffset)) {
+  }
+  float y = pendingMouseY.load();
+  while (!pendingMouseY.compare_exchange_weak(y, y + yoffset)) {
   }
-  // Delegate to camera's built-in mouse movement handler
-  camera->ProcessMouseMovement(xoffset, yoffset, constrainPitch);
 }
 
 // GAME UPDATE (Network & Game Logic)
@@ -940,6 +952,8 @@ void Game::ProcessMouseMovement(float xoffset, float yoffset,
  * @param dt Delta time since last frame
  */
 void Game::Update(float dt) {
+  TRACE_SCOPE("Game::Update");
+
   // HOST MODE: Accept incoming client connections (non-blocking)
   if (mode == GameMode::HOST && serverSocket >= 0 && clientSocket < 0) {
     // Non-blocking accept check
@@ -993,77 +1007,295 @@ void Game::Update(float dt) {
   CheckPortalProximity();
 }
 
+// SIMULATION TICKS AND THREAD HAND-OFF
+
+/**
+ * Advance the simulation
+ * Runs as many fixed ticks as fit in the accumulated frame time, or only
+ * picks up the latest snapshot when the simulation has its own thread
+ * @param frameTime Real time since the previous call
+ * @return Fraction of a tick elapsed since the latest snapshot
+ */
+float Game::Advance(float frameTime) {
+  ApplyWindowRequests();
+
+  if (simulationRunning) {
+    snapshots.Acquire();
+    float sinceTick =
+        static_cast<float>(glfwGetTime() - snapshots.Read().TickTime);
+    return glm::clamp(sinceTick / SIMULATION_STEP, 0.0f, 1.0f);
+  }
+
+  simulationAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+  while (simulationAccumulator >= SIMULATION_STEP) {
+    RunTick();
+    simulationAccumulator -= SIMULATION_STEP;
+  }
+
+  snapshots.Acquire();
+  return simulationAccumulator / SIMULATION_STEP;
+}
+
+/**
+ * Run one fixed simulation tick
+ * Applies queued mouse movement, processes input and game logic, then
+ * publishes the result for the renderer
+ */
+void Game::RunTick() {
+  TRACE_SCOPE("Game::RunTick");
+
+  previousCameraPosition = camera->Position;
+
+  float mouseX = pendingMouseX.exchange(0.0f);
+  float mouseY = pendingMouseY.exchange(0.0f);
+  float dt = SIMULATION_STEP;
+
+  if (inputRecorder && inputRecorder->IsReplaying()) {
+    // Live input is ignored; the log drives the tick
+    if (replayFinished)
+      return;
+    if (!inputRecorder->ReplayTick(tickKeys, mouseX, mouseY, dt)) {
+      std::cout << "Input replay finished." << std::endl;
+      replayFinished = true;
+      return;
+    }
+  } else {
+    for (int i = 0; i < 1024; i++)
+      tickKeys[i] = Keys[i];
+    if (inputRecorder)
+      inputRecorder->RecordTick(tickKeys, mouseX, mouseY, dt);
+  }
+
+  // Ignore mouse input when game is paused
+  if (!isPaused && (mouseX != 0.0f || mouseY != 0.0f))
+    camera->ProcessMouseMovement(mouseX, mouseY, true);
+
+  double inputStart = PerfHud::Now();
+  ProcessInput(dt);
+  double updateStart = PerfHud::Now();
+  Update(dt);
+  double updateEnd = PerfHud::Now();
+  if (perfHud) {
+    perfHud->RecordCpu(PerfHud::CPU_INPUT, updateStart - inputStart);
+    perfHud->RecordCpu(PerfHud::CPU_UPDATE, updateEnd - updateStart);
+  }
+
+  PublishSnapshot();
+}
+
+/**
+ * Publish the state of the latest tick
+ * Fills every field of the writer slot (it holds an old snapshot)
+ */
+void Game::PublishSnapshot() {
+  FrameSnapshot &snapshot = snapshots.Write();
+  snapshot.View = *camera;
+  snapshot.PreviousPosition = previousCameraPosition;
+  snapshot.TickTime = glfwGetTime();
+  snapshot.ShowingIntroDialog = showingIntroDialog;
+  snapshot.IsPaused = isPaused;
+  snapshot.EnvironmentTint = GetEnvironmentTint();
+  snapshot.MinimapViewCells = minimapViewCells;
+  snapshot.ShowPerfHud = showPerfHud;
+  snapshot.DepthPrepass = depthPrepass;
+  snapshots.Publish();
+}
+
+/**
+ * Apply window changes requested by the simulation
+ * Cursor mode and fullscreen are GLFW window calls (main thread only)
+ */
+void Game::ApplyWindowRequests() {
+  if (!windowPtr)
+    return;
+
+  int cursorMode = requestedCursorMode.exchange(-1);
+  if (cursorMode >= 0)
+    glfwSetInputMode(windowPtr, GLFW_CURSOR, cursorMode);
+
+  // Two toggles in one frame cancel out
+  if (requestedFullscreenToggles.exchange(0) % 2 == 0)
+    return;
+
+  GLFWmonitor *monitor = glfwGetWindowMonitor(windowPtr);
+  if (monitor == nullptr) {
+    // Currently in windowed mode - switch to fullscreen
+    GLFWmonitor *primaryMonitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode *mode = glfwGetVideoMode(primaryMonitor);
+    glfwSetWindowMonitor(windowPtr, primaryMonitor, 0, 0, mode->width,
+                         mode->height, mode->refreshRate);
+    std::cout << "Switched to FULLSCREEN mode" << std::endl;
+  } else {
+    // Currently in fullscreen - switch to windowed mode
+    glfwSetWindowMonitor(windowPtr, nullptr, 100, 100, Width, Height, 0);
+    std::cout << "Switched to WINDOWED mode" << std::endl;
+  }
+}
+
+/**
+ * Start the simulation thread
+ * Ticks then run independently of the frame rate
+ */
+void Game::StartSimulationThread() {
+  if (simulationRunning)
+    return;
+  simulationRunning = true;
+  simulationThread = std::thread(&Game::SimulationLoop, this);
+  std::cout << "Simulation running on its own thread ("
+            << static_cast<int>(1.0f / SIMULATION_STEP + 0.5f) << " Hz)"
+            << std::endl;
+}
+
+/**
+ * Stop the simulation thread
+ * Waits for the current tick to finish
+ */
+void Game::StopSimulationThread() {
+  simulationRunning = false;
+  if (simulationThread.joinable())
+    simulationThread.join();
+}
+
+/**
+ * Simulation thread body
+ * Runs ticks on a fixed schedule, sleeping between them. After a stall
+ * longer than MAX_FRAME_TIME the schedule restarts instead of catching up.
+ */
+void Game::SimulationLoop() {
+  TRACE_THREAD_NAME("simulation");
+
+  double nextTick = glfwGetTime();
+  while (simulationRunning) {
+    RunTick();
+    nextTick += SIMULATION_STEP;
+
+    double now = glfwGetTime();
+    if (now < nextTick) {
+      std::this_thread::sleep_for(
+          std::chrono::duration<double>(nextTick - now));
+    } else if (now - nextTick > MAX_FRAME_TIME) {
+      nextTick = now;
+    }
+  }
+}
+
+void Game::RequestTextures(const Mesh *mesh, float distance) {
+  if (!mesh)
+    return;
+  for (const Texture &texture : mesh->textures) {
+    float importance = texture.type == "texture_diffuse" ? 1.0f : 0.5f;
+    textureManager->Request(texture.id, distance, importance);
+  }
+}
+
+void Game::FinishTextureLoads() {
+  textureManager->Finish();
+  texturesLoading = false;
+}
+
 /**
  * Render the game scene
- * Handles rendering of the maze, player, and UI elements
+ * Draws the latest snapshot from a camera position interpolated between
+ * its last two ticks
+ * @param alpha Interpolation factor (0 = previous tick, 1 = latest tick)
  */
-void Game::Render() {
-  gameShader->use();
-  gameShader->setBool("isPortal", false); // Default to standard rendering
+void Game::Render(float alpha) {
+  TRACE_SCOPE("Game::Render");
+
+  double renderStart = PerfHud::Now();
+  perfHud->BeginFrame();
+  textureManager->Update();
+  texturesLoading = textureManager->Pending() > 0;
+  perfHud->SetTextureMemory(textureManager->ResidentBytes(),
+                            textureManager->MemoryBudget());
+  if (dynamicResolution) {
+    dynamicResolution->Update(perfHud->GpuMilliseconds(PerfHud::GPU_SCENE));
+    perfHud->SetResolutionScale(dynamicResolution->Scale());
+  }
 
-  // Configure flashlight (follows camera)
-  gameShader->setVec3("light.position", camera->Position.x, camera->Position.y,
-                      camera->Position.z);
-  gameShader->setVec3("light.direction", camera->Front.x, camera->Front.y,
-                      camera->Front.z);
-  gameShader->setVec3("viewPos", camera->Position.x, camera->Position.y,
-                      camera->Position.z);
+  frame = snapshots.Read();
+  renderCamera = frame.View;
+  renderCamera.Position =
+      glm::mix(frame.PreviousPosition, frame.View.Position, alpha);
 
-  // Configure spotlight cone angles (cosine of angle)
-  gameShader->setFloat("light.cutOff", glm::cos(glm::radians(12.5f)));
-  gameShader->setFloat("light.outerCutOff", glm::cos(glm::radians(17.5f)));
+  // Reveal newly visible cells on the minimap
+  UpdateExploration();
 
-  // Light colors
-  gameShader->setVec3("light.ambient", 0.2f, 0.2f, 0.2f);
-  gameShader->setVec3("light.diffuse", 0.8f, 0.8f, 0.8f);
-  gameShader->setVec3("light.specular", 1.0f, 1.0f, 1.0f);
+  RenderScene();
 
-  // Attenuation (values for ~50 meters coverage)
-  gameShader->setFloat("light.constant", 1.0f);
-  gameShader->setFloat("light.linear", 0.09f);
-  gameShader->setFloat("light.quadratic", 0.032f);
+  perfHud->RecordCpu(PerfHud::CPU_RENDER, PerfHud::Now() - renderStart);
+}
 
-  // View/Projection matrices
-  glm::mat4 projection = glm::perspective(
-      glm::radians(camera->Zoom), (float)Width / (float)Height, 0.1f, 100.0f);
-  glm::mat4 view = camera->GetViewMatrix();
+/**
+ * Render the game scene
+ * Handles rendering of the maze, player, and UI elements
+ */
+void Game::RenderScene() {
+  perfHud->BeginGpu(PerfHud::GPU_SCENE);
+  // 3D scene at the adaptive resolution; minimap and UI stay native
+  if (dynamicResolution)
+    dynamicResolution->Begin();
 
-  gameShader->setMat4("projection", glm::value_ptr(projection));
-  gameShader->setMat4("view", glm::value_ptr(view));
+  // View/Projection matrices
+  const float nearPlane = 0.1f, farPlane = 100.0f;
+  glm::mat4 projection =
+      glm::perspective(glm::radians(renderCamera.Zoom),
+                       (float)Width / (float)Height, nearPlane, farPlane);
+  glm::mat4 view = renderCamera.GetViewMatrix();
+
+  // Distance of a world position in front of the camera
+  auto viewDepth = [&view](const glm::vec3 &position) {
+    return -(view[0][2] * position.x + view[1][2] * position.y +
+             view[2][2] * position.z + view[3][2]);
+  };
+
+  // Textured variant: ground, maze and trees
+  Shader *gameShader = &sceneShaders->Get(VARIANT_TEXTURED);
+  gameShader->use();
+  SetSceneUniforms(*gameShader, projection, view);
 
   // Calculate and set environment tint based on portal proximity
-  glm::vec3 envTint = GetEnvironmentTint();
+  glm::vec3 envTint = frame.EnvironmentTint;
   gameShader->setVec3("environmentTint", envTint.x, envTint.y, envTint.z);
 
-  // Render outdoor ground first (underneath everything)
+  // Opaque draws are queued, then sorted by program, texture and depth
+  renderQueue->Clear();
+
+  // The ground spans the whole scene and lies under the maze floor: give
+  // it the far depth so it comes after everything it is hidden by
   if (outdoorGroundMesh) {
-    glm::mat4 groundModel = glm::mat4(1.0f);
-    gameShader->setMat4("model", glm::value_ptr(groundModel));
-    gameShader->setVec3("objectColor", 1.0f, 1.0f, 1.0f);
-    gameShader->setBool("useTexture", true);
-    outdoorGroundMesh->Draw(gameShader->ID);
+    renderQueue->Submit(RenderQueue::PASS_OPAQUE, *gameShader,
+                        *outdoorGroundMesh, glm::mat4(1.0f),
+                        glm::vec3(1.0f, 1.0f, 1.0f), farPlane);
   }
 
   // Render maze
   if (currentMaze) {
-    currentMaze->Draw(*gameShader);
+    currentMaze->Submit(*renderQueue, RenderQueue::PASS_OPAQUE, *gameShader,
+                        view);
   }
 
+  // The maze and the ground surround the camera: always full detail
+  RequestTextures(wall_mesh, 0.0f);
+  RequestTextures(floor_mesh, 0.0f);
+  RequestTextures(outdoorGroundMesh, 0.0f);
+
   // Render trees around the perimeter
   if (treeMesh && treePositions.size() > 0) {
-    gameShader->setBool("useTexture", true);
-
+    float nearestTree = farPlane;
     for (const glm::vec3 &treePos : treePositions) {
+      nearestTree = std::min(nearestTree,
+                             glm::distance(renderCamera.Position, treePos));
       glm::mat4 treeModel = glm::mat4(1.0f);
       treeModel = glm::translate(treeModel, treePos);
 
-      gameShader->setMat4("model", glm::value_ptr(treeModel));
-
       // Increase brightness so trees are visible even without direct flashlight
       // Trees are far from player, so they need higher ambient contribution
-      gameShader->setVec3("objectColor", 3.0f, 3.0f, 3.0f);
-      treeMesh->Draw(gameShader->ID);
+      renderQueue->Submit(RenderQueue::PASS_OPAQUE, *gameShader, *treeMesh,
+                          treeModel, glm::vec3(3.0f, 3.0f, 3.0f),
+                          viewDepth(treePos));
     }
+    RequestTextures(treeMesh, nearestTree);
   }
 
   // Render portal environment at maze end
@@ -1072,19 +1304,19 @@ void Game::Render() {
   if (gateMesh && currentMaze) {
     glm::vec3 gatePos(currentMaze->endParams.x * currentMaze->cellSize, 0.0f,
                       currentMaze->endParams.y * currentMaze->cellSize);
-    float distToPortal = glm::distance(camera->Position, gatePos);
+    float distToPortal = glm::distance(renderCamera.Position, gatePos);
 
     if (distToPortal < 50.0f) { // Always visible when in corridor
       renderPortal = true;
 
-      gameShader->setBool("useTexture", false);
-
-      // Enable Special "Liquid Silver" Shader Effect
-      gameShader->setBool("isPortal", true); // Use custom shader logic
-      gameShader->setFloat("time", (float)glfwGetTime());
+      // Special "Liquid Silver" variant (untextured, portal effect)
+      Shader *portalShader = &sceneShaders->Get(VARIANT_PORTAL);
+      portalShader->use();
+      SetSceneUniforms(*portalShader, projection, view);
+      portalShader->setFloat("time", (float)glfwGetTime());
 
       // Force environment tint to WHITE for the portal so it looks silver
-      gameShader->setVec3("environmentTint", 1.0f, 1.0f, 1.0f);
+      portalShader->setVec3("environmentTint", 1.0f, 1.0f, 1.0f);
 
       // Animation Variables
       float time = (float)glfwGetTime();
@@ -1106,28 +1338,131 @@ void Game::Render() {
       // 3. Scale (Radius 0.2 - Compact)
       gateModel = glm::scale(gateModel, glm::vec3(0.2f, 0.2f, 0.2f));
 
-      gameShader->setMat4("model", glm::value_ptr(gateModel));
-
       // Shader handles color mixing, but we pass white base just in case
-      gameShader->setVec3("objectColor", 1.0f, 1.0f, 1.0f);
+      renderQueue->Submit(RenderQueue::PASS_OPAQUE, *portalShader, *gateMesh,
+                          gateModel, glm::vec3(1.0f, 1.0f, 1.0f),
+                          viewDepth(animatedGatePos));
+    }
+  }
+
+  renderQueue->Sort();
+  perfHud->SetDepthPrepass(frame.DepthPrepass);
+  if (frame.DepthPrepass) {
+    // Depth first, then shade only the fragments that won the depth test
+    GLStateCache &state = GLStateCache::Get();
+    renderQueue->ExecuteDepthOnly(view, projection);
+    state.DepthFunc(GL_EQUAL);
+    state.DepthMask(false);
+    renderQueue->Execute();
+    state.DepthMask(true);
+    state.DepthFunc(GL_LESS);
+  } else {
+    renderQueue->Execute();
+  }
 
-      gateMesh->Draw(gameShader->ID);
+  // Torches and portal glow: additive pass over the maze and the ground
+  if (clusteredLights) {
+    float time = (float)glfwGetTime();
+    clusteredLights->Clear();
+    for (size_t i = 0; i < torchPositions.size(); i++) {
+      // Two out-of-phase waves give an irregular flicker per torch
+      float flicker = 0.85f + 0.15f * std::sin(time * 9.0f + i * 1.7f) *
+                                  std::sin(time * 5.3f + i * 0.9f);
+      clusteredLights->AddLight(torchPositions[i], 2.5f,
+                                glm::vec3(1.0f, 0.55f, 0.2f) * 1.5f * flicker);
+    }
+    if (renderPortal) {
+      glm::vec3 glowPos(currentMaze->endParams.x * currentMaze->cellSize, 0.4f,
+                        currentMaze->endParams.y * currentMaze->cellSize);
+      float pulse = 0.75f + 0.25f * std::sin(time * 3.0f);
+      clusteredLights->AddLight(glowPos, 3.0f,
+                                glm::vec3(0.4f, 0.8f, 1.0f) * 2.0f * pulse);
+    }
 
-      // Reset flags & environment settings
-      gameShader->setBool("isPortal", false);
-      gameShader->setVec3("environmentTint", envTint.x, envTint.y, envTint.z);
+    Shader *lightShader =
+        clusteredLights->Begin(view, projection, nearPlane, farPlane);
+    if (lightShader) {
+      renderQueue->Clear();
+      if (outdoorGroundMesh) {
+        renderQueue->Submit(RenderQueue::PASS_LIGHTING, *lightShader,
+                            *outdoorGroundMesh, glm::mat4(1.0f),
+                            glm::vec3(1.0f, 1.0f, 1.0f), farPlane);
+      }
+      if (currentMaze)
+        currentMaze->Submit(*renderQueue, RenderQueue::PASS_LIGHTING,
+                            *lightShader, view);
+      renderQueue->Sort();
+      renderQueue->Execute();
+      clusteredLights->End();
     }
   }
 
+  if (dynamicResolution)
+    dynamicResolution->End();
+  perfHud->EndGpu(PerfHud::GPU_SCENE);
+
   // Render Minimap (Top-Right)
+  double minimapStart = PerfHud::Now();
+  perfHud->BeginGpu(PerfHud::GPU_MINIMAP);
   RenderMinimap();
+  perfHud->EndGpu(PerfHud::GPU_MINIMAP);
+  double uiStart = PerfHud::Now();
+  perfHud->RecordCpu(PerfHud::CPU_MINIMAP, uiStart - minimapStart);
 
   // Render text overlays
-  if (showingIntroDialog) {
+  perfHud->BeginGpu(PerfHud::GPU_UI);
+  if (frame.ShowingIntroDialog) {
     RenderIntroDialog();
-  } else if (isPaused) {
+  } else if (frame.IsPaused) {
     RenderPauseOverlay();
   }
+  if (frame.ShowPerfHud && textRenderer) {
+    GLStateCache &state = GLStateCache::Get();
+    state.SetEnabled(GL_DEPTH_TEST, false);
+    state.SetEnabled(GL_BLEND, true);
+    state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    perfHud->Draw(*textRenderer, Width, Height);
+    state.SetEnabled(GL_BLEND, false);
+    state.SetEnabled(GL_DEPTH_TEST, true);
+  }
+  perfHud->EndGpu(PerfHud::GPU_UI);
+  perfHud->RecordCpu(PerfHud::CPU_UI, PerfHud::Now() - uiStart);
+}
+
+/**
+ * Set Scene Uniforms
+ * Per-frame uniforms shared by every scene shader variant: the camera
+ * flashlight and the view/projection matrices
+ * @param shader Variant to configure (must be in use)
+ * @param projection Projection matrix
+ * @param view View matrix
+ */
+void Game::SetSceneUniforms(Shader &shader, const glm::mat4 &projection,
+                            const glm::mat4 &view) {
+  // Configure flashlight (follows camera)
+  shader.setVec3("light.position", renderCamera.Position.x,
+                 renderCamera.Position.y, renderCamera.Position.z);
+  shader.setVec3("light.direction", renderCamera.Front.x,
+                 renderCamera.Front.y, renderCamera.Front.z);
+  shader.setVec3("viewPos", renderCamera.Position.x, renderCamera.Position.y,
+                 renderCamera.Position.z);
+
+  // Configure spotlight cone angles (cosine of angle)
+  shader.setFloat("light.cutOff", glm::cos(glm::radians(12.5f)));
+  shader.setFloat("light.outerCutOff", glm::cos(glm::radians(17.5f)));
+
+  // Light colors
+  shader.setVec3("light.ambient", 0.2f, 0.2f, 0.2f);
+  shader.setVec3("light.diffuse", 0.8f, 0.8f, 0.8f);
+  shader.setVec3("light.specular", 1.0f, 1.0f, 1.0f);
+
+  // Attenuation (values for ~50 meters coverage)
+  shader.setFloat("light.constant", 1.0f);
+  shader.setFloat("light.linear", 0.09f);
+  shader.setFloat("light.quadratic", 0.032f);
+
+  shader.setMat4("projection", glm::value_ptr(projection));
+  shader.setMat4("view", glm::value_ptr(view));
 }
 
 /**
@@ -1143,43 +1478,36 @@ void Game::RenderPauseOverlay() {
     InitializeOverlayResources();
   }
 
-  // Save OpenGL state
-  GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-  GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+  // Save OpenGL state (answered by the state cache, no driver query)
+  GLStateCache &state = GLStateCache::Get();
+  bool depthTestEnabled = state.IsEnabled(GL_DEPTH_TEST);
+  bool blendEnabled = state.IsEnabled(GL_BLEND);
 
-  glDisable(GL_DEPTH_TEST);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_BLEND, true);
+  state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   // Use shader and render background quad
-  glUseProgram(overlayShaderProgram);
-  glBindVertexArray(overlayVAO);
+  state.UseProgram(overlayShaderProgram);
+  state.BindVertexArray(overlayVAO);
   glDrawArrays(GL_TRIANGLES, 0, 6);
+  RenderStats::RecordDraw(6);
 
-  // Render centered "PAUSED" text
-  std::string pausedText = "PAUSED";
-  float scale = 2.0f;
-  float textWidth = textRenderer->CalculateTextWidth(pausedText, scale);
-
-  float centerX = (Width - textWidth) / 2.0f;
+  // Centered text, shaped once and redrawn from the cached layout
+  if (!pauseLayout)
+    pauseLayout = new TextLayout();
   float centerY = Height / 2.0f;
-
-  textRenderer->RenderText(pausedText, centerX, centerY, scale,
-                           glm::vec3(1.0f, 1.0f, 1.0f));
-
+  pauseLayout->SetViewport(Width, Height);
+  pauseLayout->SetLine(0, "PAUSED", 0.0f, centerY, 2.0f,
+                       glm::vec3(1.0f, 1.0f, 1.0f));
   // Instructions
-  std::string subText = "Press ESC to Resume";
-  float subScale = 1.0f;
-  float subWidth = textRenderer->CalculateTextWidth(subText, subScale);
-
-  textRenderer->RenderText(subText, (Width - subWidth) / 2.0f, centerY - 50.0f,
-                           subScale, glm::vec3(0.8f, 0.8f, 0.8f));
+  pauseLayout->SetLine(1, "Press ESC to Resume", 0.0f, centerY - 50.0f, 1.0f,
+                       glm::vec3(0.8f, 0.8f, 0.8f));
+  pauseLayout->Draw(*textRenderer);
 
   // Restore state
-  if (depthTestEnabled)
-    glEnable(GL_DEPTH_TEST);
-  if (!blendEnabled)
-    glDisable(GL_BLEND);
+  state.SetEnabled(GL_DEPTH_TEST, depthTestEnabled);
+  state.SetEnabled(GL_BLEND, blendEnabled);
 }
 
 /**
@@ -1203,9 +1531,7 @@ void Game::CheckPortalProximity() {
 
       // Pause game and show cursor
       isPaused = true;
-      if (windowPtr) {
-        glfwSetInputMode(windowPtr, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-      }
+      requestedCursorMode = GLFW_CURSOR_NORMAL;
 
       std::cout << "Game PAUSED at portal." << std::endl;
       std::cout << "Press ESC to resume and continue exploring." << std::endl;
@@ -1231,9 +1557,7 @@ void Game::CheckPortalProximity() {
 
       // Pause game
       isPaused = true;
-      if (windowPtr) {
-        glfwSetInputMode(windowPtr, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-      }
+      requestedCursorMode = GLFW_CURSOR_NORMAL;
 
       std::cout << "Press ESC to resume or close the window." << std::endl;
       connectedToPortal = true;
@@ -1246,6 +1570,8 @@ void Game::CheckPortalProximity() {
  * Handles rendering of the minimap in the top-right corner
  */
 void Game::RenderMinimap() {
+  TRACE_SCOPE("Game::RenderMinimap");
+
   if (!simpleShader || !currentMaze)
     return;
 
@@ -1260,10 +1586,11 @@ void Game::RenderMinimap() {
   glm::mat4 projection =
       glm::ortho(0.0f, (float)Width, 0.0f, (float)Height, -1.0f, 1.0f);
 
-  glDisable(GL_DEPTH_TEST); // Disable depth to draw over 3D scene
+  GLStateCache &state = GLStateCache::Get();
+  state.SetEnabled(GL_DEPTH_TEST, false); // Draw over the 3D scene
 
   simpleShader->use();
-  glBindVertexArray(minimapVAO);
+  state.BindVertexArray(minimapVAO);
 
   // 2. Draw Background (Dark Grey)
   glm::mat4 model = glm::mat4(1.0f);
@@ -1274,52 +1601,46 @@ void Game::RenderMinimap() {
   simpleShader->setMat4("MVP", glm::value_ptr(mvp));
   simpleShader->setVec3("LightColor", 0.2f, 0.2f, 0.2f); // Dark Grey Background
   glDrawArrays(GL_TRIANGLES, 0, 6);
+  RenderStats::RecordDraw(6);
+
+  // 3. Draw Maze Grid (only the pyramid tiles inside the view)
+  // Grid coordinates: cell x covers [x, x + 1), player sits at its center
+  glm::vec2 playerCell(renderCamera.Position.x / currentMaze->cellSize + 0.5f,
+                       renderCamera.Position.z / currentMaze->cellSize + 0.5f);
+  glm::vec2 mazeExtent((float)currentMaze->width, (float)currentMaze->height);
+
+  // Follow the player, but keep the view inside the maze when zoomed in
+  glm::vec2 viewCenter = playerCell;
+  float halfView = frame.MinimapViewCells * 0.5f;
+  for (int axis = 0; axis < 2; axis++) {
+    if (frame.MinimapViewCells >= mazeExtent[axis])
+      viewCenter[axis] = mazeExtent[axis] * 0.5f;
+    else
+      viewCenter[axis] = glm::clamp(viewCenter[axis], halfView,
+                                    mazeExtent[axis] - halfView);
+  }
 
-  // 3. Draw Maze Grid
-  // Calculate cell size in UI pixels
-  float cellSize = mapSize / std::max(currentMaze->width, currentMaze->height);
-
-  // Set color to Black for Walls
-  simpleShader->setVec3("LightColor", 0.0f, 0.0f, 0.0f);
-
-  for (int z = 0; z < currentMaze->height; z++) {
-    for (int x = 0; x < currentMaze->width; x++) {
-      // 0 = Wall
-      if (currentMaze->grid[z][x] == 0) {
-        float px = startX + x * cellSize;
-        // Invert Z because screen Y goes up, but grid Z goes "down" visually in
-        // top-down map (Assuming Z=0 is top of map)
-        float py = (startY + mapSize) - ((z + 1) * cellSize);
-
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(px, py, 0.0f));
-        model = glm::scale(model, glm::vec3(cellSize, cellSize, 1.0f));
-
-        mvp = projection * model;
-        simpleShader->setMat4("MVP", glm::value_ptr(mvp));
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-      }
-    }
+  if (minimapPyramid) {
+    minimapPyramid->Render(viewCenter, frame.MinimapViewCells, startX, startY,
+                           mapSize, projection);
   }
 
   // 5. Draw Player (Red)
-  // Convert World Position to Grid Coordinates
-  // Player Position is in World Units. To get Grid Coords: Pos /
-  // CellSize(World)
-  float playerGridX = camera->Position.x / currentMaze->cellSize;
-  float playerGridZ = camera->Position.z / currentMaze->cellSize;
-
-  // Scale to Minimap UI pixels
-  float uiX = startX + playerGridX * cellSize;
-  float uiY = (startY + mapSize) - (playerGridZ * cellSize) -
-              cellSize; // Approximate center
-
-  // Make player size smaller to fit in corridors
-  float playerIconSize = cellSize * 0.8f;
+  // Convert the player cell to minimap UI pixels
+  float cellSize = mapSize / frame.MinimapViewCells;
+  float uiX = startX + (playerCell.x - (viewCenter.x - halfView)) * cellSize;
+  float uiY = (startY + mapSize) -
+              (playerCell.y - (viewCenter.y - halfView)) * cellSize;
+
+  // Make player size smaller to fit in corridors (but always visible)
+  float playerIconSize = std::max(4.0f, cellSize * 0.8f);
   // Center the icon
-  uiX -= (playerIconSize - cellSize) / 2.0f;
-  uiY -= (playerIconSize - cellSize) / 2.0f;
+  uiX -= playerIconSize / 2.0f;
+  uiY -= playerIconSize / 2.0f;
 
+  // The pyramid switched program and vertex array; back to the quad
+  simpleShader->use();
+  state.BindVertexArray(minimapVAO);
   simpleShader->setVec3("LightColor", 1.0f, 0.0f, 0.0f); // Red
 
   model = glm::mat4(1.0f);
@@ -1329,9 +1650,10 @@ void Game::RenderMinimap() {
   mvp = projection * model;
   simpleShader->setMat4("MVP", glm::value_ptr(mvp));
   glDrawArrays(GL_TRIANGLES, 0, 6);
+  RenderStats::RecordDraw(6);
 
   // Restore OpenGL state
-  glEnable(GL_DEPTH_TEST);
+  state.SetEnabled(GL_DEPTH_TEST, true);
 }
 
 glm::vec3 Game::GetEnvironmentTint() {
@@ -1371,41 +1693,40 @@ void Game::RenderIntroDialog() {
     InitializeOverlayResources();
   }
 
-  // Save current OpenGL state
-  GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-  GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+  // Save current OpenGL state (answered by the state cache)
+  GLStateCache &state = GLStateCache::Get();
+  bool depthTestEnabled = state.IsEnabled(GL_DEPTH_TEST);
+  bool blendEnabled = state.IsEnabled(GL_BLEND);
 
   // Disable depth test and enable blending for 2D overlay
-  glDisable(GL_DEPTH_TEST);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_BLEND, true);
+  state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   // Use shader and render the overlay quad
-  glUseProgram(overlayShaderProgram);
-  glBindVertexArray(overlayVAO);
+  state.UseProgram(overlayShaderProgram);
+  state.BindVertexArray(overlayVAO);
   glDrawArrays(GL_TRIANGLES, 0, 6);
+  RenderStats::RecordDraw(6);
 
-  // Now render text on top of the overlay
-  float centerX = Width / 2.0f;
+  // Now render text on top of the overlay. Every line is centered and the
+  // whole block is shaped once, then redrawn from the cached layout
+  if (!introLayout)
+    introLayout = new TextLayout();
+  introLayout->SetViewport(Width, Height);
 
   // Title
-  std::string title = "Maze: Escape from yourself";
-  float titleScale = 1.5f;
-  float titleWidth = textRenderer->CalculateTextWidth(title, titleScale);
-  textRenderer->RenderText(title, (Width - titleWidth) / 2.0f, Height - 100.0f,
-                           titleScale, glm::vec3(1.0f, 1.0f, 1.0f));
+  introLayout->SetLine(0, "Maze: Escape from yourself", 0.0f, Height - 100.0f,
+                       1.5f, glm::vec3(1.0f, 1.0f, 1.0f));
 
   // Mode
-  std::string modeText =
-      (mode == GameMode::HOST) ? "MODE: HOST" : "MODE: CLIENT";
-  float modeScale = 1.0f;
-  float modeWidth = textRenderer->CalculateTextWidth(modeText, modeScale);
-  textRenderer->RenderText(modeText, (Width - modeWidth) / 2.0f,
-                           Height - 150.0f, modeScale,
-                           glm::vec3(0.8f, 0.8f, 1.0f));
-
-  // Objective
-  std::string objectiveText;
+  introLayout->SetLine(1,
+                       (mode == GameMode::HOST) ? "MODE: HOST" : "MODE: CLIENT",
+                       0.0f, Height - 150.0f, 1.0f,
+                       glm::vec3(0.8f, 0.8f, 1.0f));
+
+  // Objective (smaller scale to fit)
+  const char *objectiveText;
   if (mode == GameMode::HOST) {
     objectiveText = "'No man ever steps in the same river twice, for it's not "
                     "the same river and he's not the same man.' - Heraclitus";
@@ -1413,45 +1734,28 @@ void Game::RenderIntroDialog() {
     objectiveText = "Do you still feel like you are the same man? Is this "
                     "still the same river?";
   }
-  float objScale = 0.6f; // Smaller to fit
-  float objWidth = textRenderer->CalculateTextWidth(objectiveText, objScale);
-  textRenderer->RenderText(objectiveText, (Width - objWidth) / 2.0f,
-                           Height - 200.0f, objScale,
-                           glm::vec3(0.9f, 0.9f, 0.9f));
+  introLayout->SetLine(2, objectiveText, 0.0f, Height - 200.0f, 0.6f,
+                       glm::vec3(0.9f, 0.9f, 0.9f));
 
   // Controls
-  std::string controlsTitle = "CONTROLS:";
-  float controlsTitleWidth =
-      textRenderer->CalculateTextWidth(controlsTitle, 1.0f);
-  textRenderer->RenderText(controlsTitle, (Width - controlsTitleWidth) / 2.0f,
-                           Height - 280.0f, 1.0f, glm::vec3(1.0f, 0.9f, 0.5f));
-
-  std::string c1 = "WASD / Arrow Keys - Move";
-  float c1Width = textRenderer->CalculateTextWidth(c1, 0.7f);
-  textRenderer->RenderText(c1, (Width - c1Width) / 2.0f, Height - 320.0f, 0.7f,
-                           glm::vec3(0.9f, 0.9f, 0.9f));
-
-  std::string c2 = "Mouse - Look Around";
-  float c2Width = textRenderer->CalculateTextWidth(c2, 0.7f);
-  textRenderer->RenderText(c2, (Width - c2Width) / 2.0f, Height - 350.0f, 0.7f,
-                           glm::vec3(0.9f, 0.9f, 0.9f));
-
-  std::string c3 = "ESC - Pause/Resume";
-  float c3Width = textRenderer->CalculateTextWidth(c3, 0.7f);
-  textRenderer->RenderText(c3, (Width - c3Width) / 2.0f, Height - 380.0f, 0.7f,
-                           glm::vec3(0.9f, 0.9f, 0.9f));
+  introLayout->SetLine(3, "CONTROLS:", 0.0f, Height - 280.0f, 1.0f,
+                       glm::vec3(1.0f, 0.9f, 0.5f));
+  introLayout->SetLine(4, "WASD / Arrow Keys - Move", 0.0f, Height - 320.0f,
+                       0.7f, glm::vec3(0.9f, 0.9f, 0.9f));
+  introLayout->SetLine(5, "Mouse - Look Around", 0.0f, Height - 350.0f, 0.7f,
+                       glm::vec3(0.9f, 0.9f, 0.9f));
+  introLayout->SetLine(6, "ESC - Pause/Resume", 0.0f, Height - 380.0f, 0.7f,
+                       glm::vec3(0.9f, 0.9f, 0.9f));
 
   // Instruction to start
-  std::string startText = "Press ENTER to Start";
-  float startWidth = textRenderer->CalculateTextWidth(startText, 1.0f);
-  textRenderer->RenderText(startText, (Width - startWidth) / 2.0f, 100.0f, 1.0f,
-                           glm::vec3(0.5f, 1.0f, 0.5f));
+  introLayout->SetLine(7, "Press ENTER to Start", 0.0f, 100.0f, 1.0f,
+                       glm::vec3(0.5f, 1.0f, 0.5f));
+
+  introLayout->Draw(*textRenderer);
 
   // Restore previous OpenGL state
-  if (depthTestEnabled)
-    glEnable(GL_DEPTH_TEST);
-  if (!blendEnabled)
-    glDisable(GL_BLEND);
+  state.SetEnabled(GL_DEPTH_TEST, depthTestEnabled);
+  state.SetEnabled(GL_BLEND, blendEnabled);
 }
 
 void Game::InitializeOverlayResources() {
@@ -1465,8 +1769,9 @@ void Game::InitializeOverlayResources() {
   glGenVertexArrays(1, &overlayVAO);
   glGenBuffers(1, &overlayVBO);
 
-  glBindVertexArray(overlayVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, overlayVBO);
+  GLStateCache &state = GLStateCache::Get();
+  state.BindVertexArray(overlayVAO);
+  state.BindBuffer(GL_ARRAY_BUFFER, overlayVBO);
   glBufferData(GL_ARRAY_BUFFER, sizeof(overlayVertices), overlayVertices,
                GL_STATIC_DRAW);
 
@@ -1475,8 +1780,7 @@ void Game::InitializeOverlayResources() {
   glEnableVertexAttribArray(0);
 
   // Unbind
-  glBindVertexArray(0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  state.BindVertexArray(0);
 
   // Create simple shader for 2D rendering
   // Vertex shader - pass through NDC coordinates
@@ -1497,49 +1801,9 @@ void Game::InitializeOverlayResources() {
     }
   )";
 
-  // Compile vertex shader
-  unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-  glCompileShader(vertexShader);
-
-  // Check for shader compile errors
-  int success;
-  char infoLog[512];
-  glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-    std::cerr << "ERROR: Overlay Vertex Shader Compilation Failed\n"
-              << infoLog << std::endl;
-  }
-
-  // Compile fragment shader
-  unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-  glCompileShader(fragmentShader);
-
-  glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-    std::cerr << "ERROR: Overlay Fragment Shader Compilation Failed\n"
-              << infoLog << std::endl;
-  }
-
-  // Link shaders into program
-  overlayShaderProgram = glCreateProgram();
-  glAttachShader(overlayShaderProgram, vertexShader);
-  glAttachShader(overlayShaderProgram, fragmentShader);
-  glLinkProgram(overlayShaderProgram);
-
-  glGetProgramiv(overlayShaderProgram, GL_LINK_STATUS, &success);
-  if (!success) {
-    glGetProgramInfoLog(overlayShaderProgram, 512, NULL, infoLog);
-    std::cerr << "ERROR: Overlay Shader Program Linking Failed\n"
-              << infoLog << std::endl;
-  }
-
-  // Clean up shaders (they're linked into the program now)
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  // Compile and link (or reuse the cached binary)
+  overlayShaderProgram = ShaderCache::BuildProgram(
+      "Overlay", vertexShaderSource, fragmentShaderSource);
 
   overlayResourcesInitialized = true;
   std::cout << "Overlay resources initialized successfully!" << std::endl;
@@ -1548,11 +1812,11 @@ void Game::InitializeOverlayResources() {
 void Game::CleanupOverlayResources() {
   if (overlayResourcesInitialized) {
     if (overlayVAO != 0) {
-      glDeleteVertexArrays(1, &overlayVAO);
+      GLStateCache::Get().DeleteVertexArrays(1, &overlayVAO);
       overlayVAO = 0;
     }
     if (overlayVBO != 0) {
-      glDeleteBuffers(1, &overlayVBO);
+      GLStateCache::Get().DeleteBuffers(1, &overlayVBO);
       overlayVBO = 0;
     }
     if (overlayShaderProgram != 0) {
@@ -0,0 +1,65 @@
+/**
+ * @file GpuTimer.cpp
+ * @brief Implementation of the GpuTimer class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/GpuTimer.h"
+#include "glad/glad.h"
+
+/**
+ * @brief Creates the query objects of the ring
+ */
+GpuTimer::GpuTimer()
+    : writeIndex(0), readIndex(0), pending(0), active(false),
+      lastMilliseconds(0.0f) {
+  glGenQueries(RING_SIZE, queries);
+}
+
+/**
+ * @brief Deletes the query objects
+ */
+GpuTimer::~GpuTimer() { glDeleteQueries(RING_SIZE, queries); }
+
+/**
+ * @brief Starts a query if one is free
+ */
+void GpuTimer::Begin() {
+  if (pending == RING_SIZE)
+    return; // Every query still in flight: skip this frame
+  glBeginQuery(GL_TIME_ELAPSED, queries[writeIndex]);
+  active = true;
+}
+
+/**
+ * @brief Ends the query started by Begin
+ */
+void GpuTimer::End() {
+  if (!active)
+    return;
+  glEndQuery(GL_TIME_ELAPSED);
+  active = false;
+  writeIndex = (writeIndex + 1) % RING_SIZE;
+  pending++;
+}
+
+/**
+ * @brief Reads back every finished query, oldest first
+ */
+float GpuTimer::Poll() {
+  while (pending > 0) {
+    GLint available = 0;
+    glGetQueryObjectiv(queries[readIndex], GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (!available)
+      break; // Later queries cannot be ready before this one
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(queries[readIndex], GL_QUERY_RESULT, &nanoseconds);
+    lastMilliseconds = static_cast<float>(nanoseconds / 1.0e6);
+    readIndex = (readIndex + 1) % RING_SIZE;
+    pending--;
+  }
+  return lastMilliseconds;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file InputRecorder.cpp
+ * @brief Implementation of the InputRecorder class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/InputRecorder.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+/// Identifies input logs ("MZIN")
+const uint32_t INPUT_LOG_MAGIC = 0x4E495A4D;
+/// Bump when the file layout changes
+const uint32_t INPUT_LOG_VERSION = 1;
+
+/// Bytes of the per-tick fields before the key codes
+const size_t TICK_HEADER_SIZE = 3 * sizeof(float) + sizeof(uint16_t);
+
+} // namespace
+
+InputRecorder::InputRecorder()
+    : file(nullptr), replaying(false), seed(0), readOffset(0) {
+  memset(lastKeys, 0, sizeof(lastKeys));
+}
+
+/**
+ * @brief Closes the log being recorded
+ */
+InputRecorder::~InputRecorder() {
+  if (file)
+    fclose(file);
+}
+
+/**
+ * @brief Creates the log and writes its header
+ */
+bool InputRecorder::StartRecording(const std::string &path, uint32_t seed) {
+  file = fopen(path.c_str(), "wb");
+  if (!file) {
+    std::cerr << "ERROR: Could not create input log " << path << std::endl;
+    return false;
+  }
+  this->seed = seed;
+  const uint32_t header[3] = {INPUT_LOG_MAGIC, INPUT_LOG_VERSION, seed};
+  fwrite(header, sizeof(header), 1, file);
+  std::cout << "Recording input to " << path << " (seed " << seed << ")"
+            << std::endl;
+  return true;
+}
+
+/**
+ * @brief Reads the whole log into memory and checks its header
+ */
+bool InputRecorder::StartReplay(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << "ERROR: Could not open input log " << path << std::endl;
+    return false;
+  }
+  log.assign(std::istreambuf_iterator<char>(in),
+             std::istreambuf_iterator<char>());
+
+  uint32_t header[3];
+  if (log.size() < sizeof(header)) {
+    std::cerr << "ERROR: Input log is truncated: " << path << std::endl;
+    return false;
+  }
+  memcpy(header, log.data(), sizeof(header));
+  if (header[0] != INPUT_LOG_MAGIC || header[1] != INPUT_LOG_VERSION) {
+    std::cerr << "ERROR: Not a compatible input log: " << path << std::endl;
+    return false;
+  }
+
+  seed = header[2];
+  readOffset = sizeof(header);
+  replaying = true;
+  std::cout << "Replaying input from " << path << " (seed " << seed << ")"
+            << std::endl;
+  return true;
+}
+
+/**
+ * @brief Writes the tick's dt, mouse movement and changed keys
+ */
+void InputRecorder::RecordTick(const bool *keys, float mouseX, float mouseY,
+                               float dt) {
+  if (!file)
+    return;
+
+  uint16_t changed[KEY_COUNT];
+  uint16_t changedCount = 0;
+  for (int key = 0; key < KEY_COUNT; key++) {
+    if (keys[key] != lastKeys[key]) {
+      changed[changedCount++] = static_cast<uint16_t>(key);
+      lastKeys[key] = keys[key];
+    }
+  }
+
+  const float values[3] = {dt, mouseX, mouseY};
+  fwrite(values, sizeof(values), 1, file);
+  fwrite(&changedCount, sizeof(changedCount), 1, file);
+  if (changedCount > 0)
+    fwrite(changed, sizeof(uint16_t), changedCount, file);
+}
+
+/**
+ * @brief Decodes the next tick and toggles the keys that changed
+ */
+bool InputRecorder::ReplayTick(bool *keys, float &mouseX, float &mouseY,
+                               float &dt) {
+  if (!replaying || log.size() - readOffset < TICK_HEADER_SIZE)
+    return false;
+
+  float values[3];
+  uint16_t changedCount;
+  memcpy(values, &log[readOffset], sizeof(values));
+  memcpy(&changedCount, &log[readOffset + sizeof(values)],
+         sizeof(changedCount));
+  size_t keyBytes = changedCount * sizeof(uint16_t);
+  if (log.size() - readOffset - TICK_HEADER_SIZE < keyBytes)
+    return false; // Truncated last tick
+
+  const unsigned char *codes = &log[readOffset + TICK_HEADER_SIZE];
+  for (uint16_t i = 0; i < changedCount; i++) {
+    uint16_t key;
+    memcpy(&key, codes + i * sizeof(uint16_t), sizeof(key));
+    if (key < KEY_COUNT)
+      keys[key] = !keys[key];
+  }
+  readOffset += TICK_HEADER_SIZE + keyBytes;
+
+  dt = values[0];
+  mouseX = values[1];
+  mouseY = values[2];
+  return true;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the MappedFile class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : MappedFile() {
+  *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    data = other.data;
+    size = other.size;
+    contents = std::move(other.contents); // Keeps its buffer, data stays valid
+    other.data = nullptr;
+    other.size = 0;
+  }
+  return *this;
+}
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+  contents.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(contents.data()), contents.size());
+  if (!file || contents.empty()) {
+    contents.clear();
+    return false;
+  }
+  data = contents.data();
+  size = contents.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+  void *mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+  close(fd); // The mapping stays valid
+  if (mapping == MAP_FAILED)
+    return false;
+  // Start reading ahead now; cooked files are consumed whole
+  madvise(mapping, static_cast<size_t>(info.st_size), MADV_WILLNEED);
+  data = static_cast<const unsigned char *>(mapping);
+  size = static_cast<size_t>(info.st_size);
+#endif
+  return true;
+}
+
+void MappedFile::Close() {
+#ifndef _WIN32
+  if (data)
+    munmap(const_cast<unsigned char *>(data), size);
+#endif
+  contents.clear();
+  contents.shrink_to_fit();
+  data = nullptr;
+  size = 0;
+}
@@ -6,14 +6,19 @@
  */
 
 #include "../include/Maze.h"
+#include "../include/RenderQueue.h"
+#include "../include/Trace.h"
 #include <glm/gtc/type_ptr.hpp>
 
 /**
  * @brief Generates the procedural maze
  * @param w Width of the maze
  * @param h Height of the maze
+ * @param seed Random seed (the same seed gives the same maze)
  */
-void Maze::Generate(int w, int h) {
+void Maze::Generate(int w, int h, uint32_t seed) {
+  TRACE_SCOPE("Maze::Generate");
+
   // Algorithm only works with odd numbers for maze size
   if (w % 2 == 0)
     w++;
@@ -29,7 +34,7 @@ void Maze::Generate(int w, int h) {
     maze::kruskal generator(h, w);
 
     // generate the maze
-    generator.generate();
+    generator.generate(seed);
 
     // extract the 2d grid
     this->grid = generator.get_maze();
@@ -45,17 +50,22 @@ void Maze::Generate(int w, int h) {
     }
   found_end:
 
-    std::cout << "Maze generated successfully: " << w << "x" << h << std::endl;
+    std::cout << "Maze generated successfully: " << w << "x" << h
+              << " (seed " << seed << ")" << std::endl;
   } catch (const std::exception &e) {
     std::cout << "Error generating maze: " << e.what() << std::endl;
   }
 }
 
 /**
- * @brief Renders the maze
+ * @brief Queues one draw per cell
+ * @param queue Render queue of the frame
+ * @param pass Queue pass of the draws
  * @param shader Reference to the shader
+ * @param view Camera view matrix
  */
-void Maze::Draw(Shader &shader) {
+void Maze::Submit(RenderQueue &queue, unsigned int pass, Shader &shader,
+                  const glm::mat4 &view) {
   // Iterate through grid
   for (int z = 0; z < height; z++) {
     for (int x = 0; x < width; x++) {
@@ -68,29 +78,26 @@ void Maze::Draw(Shader &shader) {
 
       glm::mat4 model = glm::mat4(1.0f);
       model = glm::translate(model, position);
-      shader.setMat4("model", glm::value_ptr(model));
 
-      // VERIFICATION: Ferenc's code uses 0 for wall and 1 for path
+      // Distance in front of the camera (-z of the view-space position)
+      float depth = -(view[0][2] * position.x + view[1][2] * position.y +
+                      view[2][2] * position.z + view[3][2]);
 
-      shader.setBool("useTexture", true); // Enable texturing
+      // VERIFICATION: Ferenc's code uses 0 for wall and 1 for path
+      // Texture binding is handled by Mesh::Draw
 
       if (grid[z][x] == 0) {
-        // IT'S A WALL
-        shader.setVec3("objectColor", 1.0f, 1.0f,
-                       1.0f); // White to not tint texture
-        // Texture binding is handled by Mesh::Draw
-        wallMesh->Draw(shader.ID);
+        // IT'S A WALL (white to not tint texture)
+        queue.Submit(pass, shader, *wallMesh, model,
+                     glm::vec3(1.0f, 1.0f, 1.0f), depth);
       } else if (x == endParams.x && z == endParams.y) {
         // END POINT - Green
-        shader.setVec3("objectColor", 0.0f, 1.0f, 0.0f);
-        // Texture binding is handled by Mesh::Draw
-        floorMesh->Draw(shader.ID);
+        queue.Submit(pass, shader, *floorMesh, model,
+                     glm::vec3(0.0f, 1.0f, 0.0f), depth);
       } else {
-        // IT'S A PATH (Draw floor)
-        shader.setVec3("objectColor", 0.6f, 0.6f,
-                       0.6f); // Grey to see texture better
-        // Texture binding is handled by Mesh::Draw
-        floorMesh->Draw(shader.ID);
+        // IT'S A PATH (grey to see texture better)
+        queue.Submit(pass, shader, *floorMesh, model,
+                     glm::vec3(0.6f, 0.6f, 0.6f), depth);
       }
     }
   }
@@ -0,0 +1,224 @@
+/**
+ * @file MeshCache.cpp
+ * @brief Implementation of the MeshCache class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/MeshCache.h"
+#include "../include/AssetCache.h"
+#include "../include/ObjParser.h"
+#include "../include/Trace.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+/// Identifies cooked mesh files ("MZMS")
+const uint32_t MESH_CACHE_MAGIC = 0x534d5a4d;
+/// Bump when the file layout or the cooking changes
+const uint32_t MESH_CACHE_VERSION = 2;
+
+/// Header as stored in the file
+struct MeshHeader {
+  uint32_t magic, version, vertexSize, vertexCount, indexCount, reserved;
+  float boundsMin[3], boundsMax[3];
+};
+
+/// OBJ position/normal/UV index triple identifying one output vertex
+typedef std::array<int, 3> CornerKey;
+
+struct CornerKeyHash {
+  size_t operator()(const CornerKey &key) const {
+    return static_cast<size_t>(AssetCache::Hash(key.data(), sizeof(key)));
+  }
+};
+
+} // namespace
+
+CookedMesh::CookedMesh()
+    : Vertices(nullptr), VertexCount(0), Indices(nullptr), IndexCount(0),
+      BoundsMin(0.0f), BoundsMax(0.0f) {}
+
+void CookedMesh::Release() {
+  file.Close();
+  vertexStorage.clear();
+  vertexStorage.shrink_to_fit();
+  indexStorage.clear();
+  indexStorage.shrink_to_fit();
+  Vertices = nullptr;
+  Indices = nullptr;
+  VertexCount = IndexCount = 0;
+  BoundsMin = BoundsMax = glm::vec3(0.0f);
+}
+
+/**
+ * @brief Maps the cooked file, cooking (and storing) it on a miss
+ */
+bool MeshCache::LoadObj(const std::string &path, float scale,
+                        CookedMesh &mesh) {
+  TRACE_SCOPE("MeshCache::LoadObj");
+  uint64_t key = AssetCache::HashFileStamp(path);
+  key = AssetCache::Hash(&scale, sizeof(scale), key);
+  std::string cachePath = AssetCache::PathFor("meshes", key, ".mesh");
+  if (MapCooked(cachePath, mesh))
+    return true;
+
+  if (!CookObj(path, scale, mesh))
+    return false;
+  WriteCooked(cachePath, mesh);
+  return true;
+}
+
+/**
+ * @brief Maps a cooked file and checks its layout
+ * @param cachePath Cache file
+ * @param mesh Filled on success
+ * @return false if the file is missing, outdated or truncated
+ */
+bool MeshCache::MapCooked(const std::string &cachePath, CookedMesh &mesh) {
+  mesh.Release();
+  if (!mesh.file.Open(cachePath))
+    return false;
+  const unsigned char *base = mesh.file.Data();
+  size_t fileSize = mesh.file.Size();
+
+  MeshHeader header;
+  if (fileSize < sizeof(header)) {
+    mesh.Release();
+    return false;
+  }
+  std::memcpy(&header, base, sizeof(header));
+  size_t expected = sizeof(header) +
+                    static_cast<size_t>(header.vertexCount) * sizeof(Vertex) +
+                    static_cast<size_t>(header.indexCount) * sizeof(unsigned);
+  if (header.magic != MESH_CACHE_MAGIC ||
+      header.version != MESH_CACHE_VERSION ||
+      header.vertexSize != sizeof(Vertex) || header.vertexCount == 0 ||
+      fileSize != expected) {
+    mesh.Release();
+    return false;
+  }
+
+  // The 48-byte header keeps both blobs 4-byte aligned in the mapping
+  mesh.Vertices = reinterpret_cast<const Vertex *>(base + sizeof(header));
+  mesh.VertexCount = header.vertexCount;
+  mesh.Indices = reinterpret_cast<const unsigned int *>(
+      base + sizeof(header) + mesh.VertexCount * sizeof(Vertex));
+  mesh.IndexCount = header.indexCount;
+  mesh.BoundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1],
+                             header.boundsMin[2]);
+  mesh.BoundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1],
+                             header.boundsMax[2]);
+  return true;
+}
+
+/**
+ * @brief Parses an OBJ file into an indexed, centred and scaled mesh
+ * @param path Source OBJ file
+ * @param scale Uniform scale applied after centring
+ * @param mesh Filled on success
+ * @return false if the model could not be loaded or has no faces
+ */
+bool MeshCache::CookObj(const std::string &path, float scale,
+                        CookedMesh &mesh) {
+  TRACE_SCOPE("MeshCache::CookObj");
+  mesh.Release();
+
+  ObjData obj;
+  if (!ObjParser::Parse(path, obj) || obj.TriangleCount() == 0)
+    return false;
+
+  // Corners with the same indices share a vertex
+  std::vector<Vertex> &vertices = mesh.vertexStorage;
+  std::vector<unsigned int> &indices = mesh.indexStorage;
+  indices.reserve(obj.Corners.size() / 3);
+  std::unordered_map<CornerKey, unsigned int, CornerKeyHash> corners;
+  for (size_t i = 0; i < obj.Corners.size(); i += 3) {
+    CornerKey key = {obj.Corners[i], obj.Corners[i + 1], obj.Corners[i + 2]};
+    auto found = corners.find(key);
+    if (found != corners.end()) {
+      indices.push_back(found->second);
+      continue;
+    }
+
+    Vertex vertex;
+    vertex.Position = glm::vec3(obj.Positions[3 * key[0] + 0],
+                                obj.Positions[3 * key[0] + 1],
+                                obj.Positions[3 * key[0] + 2]);
+    if (key[1] >= 0) {
+      vertex.Normal = glm::vec3(obj.Normals[3 * key[1] + 0],
+                                obj.Normals[3 * key[1] + 1],
+                                obj.Normals[3 * key[1] + 2]);
+    } else {
+      vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+    if (key[2] >= 0) {
+      vertex.TexCoords = glm::vec2(obj.TexCoords[2 * key[2] + 0],
+                                   obj.TexCoords[2 * key[2] + 1]);
+    } else {
+      vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+    }
+
+    unsigned int index = static_cast<unsigned int>(vertices.size());
+    corners.emplace(key, index);
+    vertices.push_back(vertex);
+    indices.push_back(index);
+  }
+  if (vertices.empty())
+    return false;
+
+  // Centre on X/Z, rest on y = 0, then scale
+  glm::vec3 low = vertices[0].Position, high = vertices[0].Position;
+  for (const Vertex &v : vertices) {
+    low = glm::min(low, v.Position);
+    high = glm::max(high, v.Position);
+  }
+  glm::vec3 origin((low.x + high.x) / 2.0f, low.y, (low.z + high.z) / 2.0f);
+  for (Vertex &v : vertices)
+    v.Position = (v.Position - origin) * scale;
+
+  mesh.Vertices = vertices.data();
+  mesh.VertexCount = vertices.size();
+  mesh.Indices = indices.data();
+  mesh.IndexCount = indices.size();
+  mesh.BoundsMin = (low - origin) * scale;
+  mesh.BoundsMax = (high - origin) * scale;
+  std::cout << "Cooked mesh: " << path << " (" << mesh.VertexCount
+            << " vertices, " << mesh.IndexCount / 3 << " triangles)"
+            << std::endl;
+  return true;
+}
+
+/**
+ * @brief Stores a cooked mesh for the next launch
+ * @param cachePath Cache file
+ * @param mesh Freshly cooked mesh
+ */
+void MeshCache::WriteCooked(const std::string &cachePath,
+                            const CookedMesh &mesh) {
+  // Another process may be uploading straight from a mapping of this file
+  bool written = AssetCache::WriteAtomic(cachePath, [&](std::ostream &file) {
+    MeshHeader header = {
+        MESH_CACHE_MAGIC,
+        MESH_CACHE_VERSION,
+        static_cast<uint32_t>(sizeof(Vertex)),
+        static_cast<uint32_t>(mesh.VertexCount),
+        static_cast<uint32_t>(mesh.IndexCount),
+        0,
+        {mesh.BoundsMin.x, mesh.BoundsMin.y, mesh.BoundsMin.z},
+        {mesh.BoundsMax.x, mesh.BoundsMax.y, mesh.BoundsMax.z}};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(mesh.Vertices),
+               mesh.VertexCount * sizeof(Vertex));
+    file.write(reinterpret_cast<const char *>(mesh.Indices),
+               mesh.IndexCount * sizeof(unsigned int));
+  });
+  if (!written) {
+    std::cout << "WARNING: Could not write mesh cache: " << cachePath
+              << std::endl;
+  }
+}
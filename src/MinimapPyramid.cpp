@@ -0,0 +1,456 @@
+/**
+ * @file MinimapPyramid.cpp
+ * @brief Implementation of the MinimapPyramid class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/MinimapPyramid.h"
+#include "../include/GLStateCache.h"
+#include "../include/Maze.h"
+#include "../include/RenderStats.h"
+#include "../include/ShaderCache.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+/**
+ * @brief Constructs an empty pyramid (GL resources are created lazily)
+ */
+MinimapPyramid::MinimapPyramid()
+    : frameCounter(0), shaderProgram(0), VAO(0), VBO(0), projectionLoc(-1),
+      rectLoc(-1) {}
+
+/**
+ * @brief Frees all tile textures and the shader/quad resources
+ */
+MinimapPyramid::~MinimapPyramid() {
+  ReleaseTiles();
+  if (VAO != 0)
+    GLStateCache::Get().DeleteVertexArrays(1, &VAO);
+  if (VBO != 0)
+    GLStateCache::Get().DeleteBuffers(1, &VBO);
+  if (shaderProgram != 0)
+    glDeleteProgram(shaderProgram);
+}
+
+/**
+ * @brief Packs (level, tx, ty) into a single hash key
+ */
+uint64_t MinimapPyramid::TileKey(int level, int tx, int ty) {
+  return (static_cast<uint64_t>(level) << 48) |
+         (static_cast<uint64_t>(static_cast<uint32_t>(ty) & 0xFFFFFF) << 24) |
+         (static_cast<uint64_t>(static_cast<uint32_t>(tx) & 0xFFFFFF));
+}
+
+/**
+ * @brief Recomputes one texel of a coarse level from its 2x2 children
+ * @param fine Texels of the level below
+ * @param fineWidth Width of the level below
+ * @param fineHeight Height of the level below
+ * @param coarse Texels of the level being written
+ * @param coarseWidth Width of the level being written
+ * @param x Texel column in the coarse level
+ * @param y Texel row in the coarse level
+ */
+static void DownsampleTexel(const std::vector<unsigned char> &fine,
+                            int fineWidth, int fineHeight,
+                            std::vector<unsigned char> &coarse,
+                            int coarseWidth, int x, int y) {
+  int wallSum = 0, seenSum = 0, count = 0;
+  for (int dy = 0; dy < 2; dy++) {
+    int fy = y * 2 + dy;
+    if (fy >= fineHeight)
+      continue;
+    for (int dx = 0; dx < 2; dx++) {
+      int fx = x * 2 + dx;
+      if (fx >= fineWidth)
+        continue;
+      size_t src = (static_cast<size_t>(fy) * fineWidth + fx) * 2;
+      wallSum += fine[src];
+      seenSum += fine[src + 1];
+      count++;
+    }
+  }
+  size_t dst = (static_cast<size_t>(y) * coarseWidth + x) * 2;
+  coarse[dst] = static_cast<unsigned char>(wallSum / count);
+  coarse[dst + 1] = static_cast<unsigned char>(seenSum / count);
+}
+
+/**
+ * @brief Builds all pyramid levels from the maze grid
+ * @param maze Maze to sample
+ * @param revealAll Start with every cell seen
+ */
+void MinimapPyramid::Build(const Maze &maze, bool revealAll) {
+  ReleaseTiles();
+  levels.clear();
+  baseWalls.clear();
+
+  if (maze.width <= 0 || maze.height <= 0)
+    return;
+
+  // Level 0: one texel per cell
+  Level base;
+  base.width = maze.width;
+  base.height = maze.height;
+  base.texels.assign(static_cast<size_t>(base.width) * base.height * 2, 0);
+  baseWalls.resize(static_cast<size_t>(base.width) * base.height);
+  for (int z = 0; z < base.height; z++) {
+    const std::vector<uint32_t> &row = maze.grid[z];
+    for (int x = 0; x < base.width; x++) {
+      size_t index = static_cast<size_t>(z) * base.width + x;
+      baseWalls[index] = (row[x] == 0);
+      if (revealAll) {
+        base.texels[index * 2] = baseWalls[index] ? 255 : 0;
+        base.texels[index * 2 + 1] = 255;
+      }
+    }
+  }
+  levels.push_back(std::move(base));
+
+  // Coarser levels: average 2x2 blocks until a single tile covers everything
+  while (levels.back().width > TILE_SIZE || levels.back().height > TILE_SIZE) {
+    const Level &fine = levels.back();
+    Level coarse;
+    coarse.width = (fine.width + 1) / 2;
+    coarse.height = (fine.height + 1) / 2;
+    coarse.texels.assign(static_cast<size_t>(coarse.width) * coarse.height * 2,
+                         0);
+
+    if (revealAll) {
+      for (int y = 0; y < coarse.height; y++) {
+        for (int x = 0; x < coarse.width; x++) {
+          DownsampleTexel(fine.texels, fine.width, fine.height, coarse.texels,
+                          coarse.width, x, y);
+        }
+      }
+    }
+    levels.push_back(std::move(coarse));
+  }
+
+  for (Level &level : levels) {
+    level.tilesX = (level.width + TILE_SIZE - 1) / TILE_SIZE;
+    level.tilesY = (level.height + TILE_SIZE - 1) / TILE_SIZE;
+  }
+
+  std::cout << "Minimap pyramid built with " << levels.size() << " levels"
+            << std::endl;
+}
+
+/**
+ * @brief Marks cells as seen and propagates them up the pyramid
+ * @param cells Newly seen cells
+ */
+void MinimapPyramid::Reveal(const std::vector<glm::ivec2> &cells) {
+  if (levels.empty() || cells.empty())
+    return;
+
+  // Level 0
+  Level &base = levels[0];
+  std::vector<glm::ivec2> touched;
+  touched.reserve(cells.size());
+  for (const glm::ivec2 &cell : cells) {
+    if (cell.x < 0 || cell.x >= base.width || cell.y < 0 ||
+        cell.y >= base.height)
+      continue;
+    size_t index = static_cast<size_t>(cell.y) * base.width + cell.x;
+    base.texels[index * 2] = baseWalls[index] ? 255 : 0;
+    base.texels[index * 2 + 1] = 255;
+    MarkDirty(0, cell.x, cell.y);
+    touched.push_back(cell);
+  }
+
+  // Coarser levels: only the parents of touched texels are recomputed
+  for (size_t l = 1; l < levels.size() && !touched.empty(); l++) {
+    const Level &fine = levels[l - 1];
+    Level &coarse = levels[l];
+
+    std::vector<glm::ivec2> parents;
+    parents.reserve(touched.size());
+    for (const glm::ivec2 &t : touched) {
+      parents.push_back(glm::ivec2(t.x / 2, t.y / 2));
+    }
+    std::sort(parents.begin(), parents.end(),
+              [](const glm::ivec2 &a, const glm::ivec2 &b) {
+                return a.y != b.y ? a.y < b.y : a.x < b.x;
+              });
+    parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+
+    for (const glm::ivec2 &p : parents) {
+      DownsampleTexel(fine.texels, fine.width, fine.height, coarse.texels,
+                      coarse.width, p.x, p.y);
+      MarkDirty(static_cast<int>(l), p.x, p.y);
+    }
+    touched.swap(parents);
+  }
+}
+
+/**
+ * @brief Grows the dirty rectangle of a resident tile to include a texel
+ *
+ * Tiles that are not resident need nothing: they are uploaded in full from
+ * the up-to-date level data when they come into view.
+ */
+void MinimapPyramid::MarkDirty(int level, int x, int y) {
+  int tx = x / TILE_SIZE;
+  int ty = y / TILE_SIZE;
+  auto it = residentTiles.find(TileKey(level, tx, ty));
+  if (it == residentTiles.end())
+    return;
+
+  Tile &tile = it->second;
+  int lx = x - tx * TILE_SIZE;
+  int ly = y - ty * TILE_SIZE;
+  if (tile.dirtyX0 > tile.dirtyX1) {
+    tile.dirtyX0 = tile.dirtyX1 = lx;
+    tile.dirtyY0 = tile.dirtyY1 = ly;
+  } else {
+    tile.dirtyX0 = std::min(tile.dirtyX0, lx);
+    tile.dirtyX1 = std::max(tile.dirtyX1, lx);
+    tile.dirtyY0 = std::min(tile.dirtyY0, ly);
+    tile.dirtyY1 = std::max(tile.dirtyY1, ly);
+  }
+}
+
+/**
+ * @brief Draws the tiles intersecting the current view
+ */
+void MinimapPyramid::Render(const glm::vec2 &center, float viewCells,
+                            float rectX, float rectY, float rectSize,
+                            const glm::mat4 &projection) {
+  if (levels.empty() || viewCells <= 0.0f || rectSize <= 0.0f)
+    return;
+
+  if (shaderProgram == 0)
+    InitializeResources();
+
+  frameCounter++;
+
+  // Choose the level where one texel is closest to (but not below) one pixel
+  float cellsPerPixel = viewCells / rectSize;
+  int level = 0;
+  while (level + 1 < static_cast<int>(levels.size()) &&
+         static_cast<float>(1 << (level + 1)) <= cellsPerPixel) {
+    level++;
+  }
+  const Level &lvl = levels[level];
+
+  float cellsPerTexel = static_cast<float>(1 << level);
+  float cellsPerTile = cellsPerTexel * TILE_SIZE;
+  float pixelsPerCell = rectSize / viewCells;
+
+  float minX = center.x - viewCells * 0.5f;
+  float minZ = center.y - viewCells * 0.5f;
+  float maxX = minX + viewCells;
+  float maxZ = minZ + viewCells;
+
+  int tx0 = std::max(0, static_cast<int>(std::floor(minX / cellsPerTile)));
+  int ty0 = std::max(0, static_cast<int>(std::floor(minZ / cellsPerTile)));
+  int tx1 = std::min(lvl.tilesX - 1,
+                     static_cast<int>(std::floor(maxX / cellsPerTile)));
+  int ty1 = std::min(lvl.tilesY - 1,
+                     static_cast<int>(std::floor(maxZ / cellsPerTile)));
+
+  GLStateCache &state = GLStateCache::Get();
+  state.SetEnabled(GL_SCISSOR_TEST, true);
+  glScissor(static_cast<GLint>(rectX), static_cast<GLint>(rectY),
+            static_cast<GLsizei>(rectSize), static_cast<GLsizei>(rectSize));
+
+  state.UseProgram(shaderProgram);
+  glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+  state.BindVertexArray(VAO);
+
+  int uploadsLeft = MAX_UPLOADS_PER_FRAME;
+  for (int ty = ty0; ty <= ty1; ty++) {
+    for (int tx = tx0; tx <= tx1; tx++) {
+      unsigned int texture = AcquireTile(level, tx, ty, uploadsLeft);
+      if (texture == 0)
+        continue; // Not streamed in yet, background shows through
+
+      // Tile extent in cells, then in screen pixels (grid Z grows downwards)
+      float cellX = tx * cellsPerTile;
+      float cellZ = ty * cellsPerTile;
+      float left = rectX + (cellX - minX) * pixelsPerCell;
+      float top = rectY + rectSize - (cellZ - minZ) * pixelsPerCell;
+      float side = cellsPerTile * pixelsPerCell;
+
+      glUniform4f(rectLoc, left, top - side, side, side);
+      state.BindTexture(0, GL_TEXTURE_2D, texture);
+      glDrawArrays(GL_TRIANGLES, 0, 6);
+      RenderStats::RecordDraw(6);
+    }
+  }
+
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+}
+
+/**
+ * @brief Returns the texture of a tile, uploading it if needed
+ *
+ * When the cache is full the least recently drawn tile is recycled. Returns
+ * 0 if the tile is not resident and the per-frame upload budget is spent.
+ */
+unsigned int MinimapPyramid::AcquireTile(int level, int tx, int ty,
+                                         int &uploadsLeft) {
+  uint64_t key = TileKey(level, tx, ty);
+  auto it = residentTiles.find(key);
+  if (it != residentTiles.end()) {
+    it->second.lastUsed = frameCounter;
+    if (it->second.dirtyX0 <= it->second.dirtyX1)
+      UploadDirtyRect(it->second, level, tx, ty);
+    return it->second.texture;
+  }
+
+  if (uploadsLeft <= 0)
+    return 0;
+  uploadsLeft--;
+
+  unsigned int texture = 0;
+  if (residentTiles.size() >= MAX_RESIDENT_TILES) {
+    // Recycle the least recently used tile that is not part of this frame
+    auto victim = residentTiles.end();
+    for (auto cur = residentTiles.begin(); cur != residentTiles.end(); ++cur) {
+      if (cur->second.lastUsed == frameCounter)
+        continue;
+      if (victim == residentTiles.end() ||
+          cur->second.lastUsed < victim->second.lastUsed)
+        victim = cur;
+    }
+    if (victim == residentTiles.end())
+      return 0;
+    texture = victim->second.texture;
+    residentTiles.erase(victim);
+  } else {
+    glGenTextures(1, &texture);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  }
+
+  UploadTile(texture, level, tx, ty);
+  residentTiles[key] = {texture, frameCounter, 1, 1, 0, 0};
+  return texture;
+}
+
+/**
+ * @brief Copies one tile out of its level and uploads it as GL_RG8
+ *
+ * Texels beyond the level edge are padded with 0 (fog colour).
+ */
+void MinimapPyramid::UploadTile(unsigned int texture, int level, int tx,
+                                int ty) {
+  const Level &lvl = levels[level];
+  std::vector<unsigned char> pixels(TILE_SIZE * TILE_SIZE * 2, 0);
+
+  int x0 = tx * TILE_SIZE;
+  int y0 = ty * TILE_SIZE;
+  int w = std::min(TILE_SIZE, lvl.width - x0);
+  int h = std::min(TILE_SIZE, lvl.height - y0);
+  for (int y = 0; y < h; y++) {
+    std::copy_n(
+        &lvl.texels[(static_cast<size_t>(y0 + y) * lvl.width + x0) * 2], w * 2,
+        &pixels[static_cast<size_t>(y) * TILE_SIZE * 2]);
+  }
+
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, TILE_SIZE, TILE_SIZE, 0, GL_RG,
+               GL_UNSIGNED_BYTE, pixels.data());
+}
+
+/**
+ * @brief Uploads only the dirty rectangle of a resident tile
+ *
+ * Reads straight from the level data using GL_UNPACK_ROW_LENGTH, so no
+ * staging copy is needed.
+ */
+void MinimapPyramid::UploadDirtyRect(Tile &tile, int level, int tx, int ty) {
+  const Level &lvl = levels[level];
+  int x = tx * TILE_SIZE + tile.dirtyX0;
+  int y = ty * TILE_SIZE + tile.dirtyY0;
+  int w = tile.dirtyX1 - tile.dirtyX0 + 1;
+  int h = tile.dirtyY1 - tile.dirtyY0 + 1;
+
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, tile.texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, lvl.width);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, tile.dirtyX0, tile.dirtyY0, w, h, GL_RG,
+                  GL_UNSIGNED_BYTE,
+                  &lvl.texels[(static_cast<size_t>(y) * lvl.width + x) * 2]);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+  tile.dirtyX0 = 1;
+  tile.dirtyX1 = 0;
+}
+
+/**
+ * @brief Deletes every resident tile texture
+ */
+void MinimapPyramid::ReleaseTiles() {
+  for (auto &entry : residentTiles) {
+    GLStateCache::Get().DeleteTextures(1, &entry.second.texture);
+  }
+  residentTiles.clear();
+}
+
+/**
+ * @brief Creates the tile shader and the unit quad
+ */
+void MinimapPyramid::InitializeResources() {
+  // Unit quad, scaled/offset into the tile rectangle by the vertex shader
+  float quadVertices[] = {0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
+                          1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+
+  glGenVertexArrays(1, &VAO);
+  glGenBuffers(1, &VBO);
+  GLStateCache &state = GLStateCache::Get();
+  state.BindVertexArray(VAO);
+  state.BindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices,
+               GL_STATIC_DRAW);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
+  state.BindVertexArray(0);
+
+  const char *vertexShaderSource = R"(
+    #version 330 core
+    layout (location = 0) in vec2 aPos;
+    out vec2 TexCoords;
+    uniform mat4 projection;
+    uniform vec4 rect; // x, y, width, height in pixels
+    void main() {
+      gl_Position = projection * vec4(rect.xy + aPos * rect.zw, 0.0, 1.0);
+      // Row 0 of the tile is the top edge of the quad
+      TexCoords = vec2(aPos.x, 1.0 - aPos.y);
+    }
+  )";
+
+  const char *fragmentShaderSource = R"(
+    #version 330 core
+    in vec2 TexCoords;
+    out vec4 FragColor;
+    uniform sampler2D tile;
+    void main() {
+      vec2 texel = texture(tile, TexCoords).rg; // (seen walls, seen cells)
+      float seen = texel.g;
+      float wall = seen > 0.0 ? texel.r / seen : 0.0;
+      vec3 fogColor = vec3(0.2); // Same grey as the minimap background
+      vec3 pathColor = vec3(0.45);
+      vec3 wallColor = vec3(0.0);
+      vec3 known = mix(pathColor, wallColor, wall);
+      FragColor = vec4(mix(fogColor, known, seen), 1.0);
+    }
+  )";
+
+  shaderProgram = ShaderCache::BuildProgram("Minimap", vertexShaderSource,
+                                            fragmentShaderSource);
+
+  projectionLoc = glGetUniformLocation(shaderProgram, "projection");
+  rectLoc = glGetUniformLocation(shaderProgram, "rect");
+  state.UseProgram(shaderProgram);
+  glUniform1i(glGetUniformLocation(shaderProgram, "tile"), 0);
+}
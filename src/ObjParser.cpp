@@ -0,0 +1,343 @@
+/**
+ * @file ObjParser.cpp
+ * @brief Implementation of the ObjParser class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/ObjParser.h"
+#include "../include/MappedFile.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+/// A triangle corner as parsed within one chunk
+struct ChunkCorner {
+  /// Position, normal and texture coordinate index (-1 = absent)
+  int index[3];
+  /// Bit i set: index[i] counts from the first element of the chunk
+  unsigned char relative;
+};
+
+/// One line-aligned slice of the file and what it contains
+struct Chunk {
+  const char *begin, *end;
+  std::vector<float> positions, normals, texCoords;
+  std::vector<ChunkCorner> corners;
+  /// Elements (and corners) of all earlier chunks, set before the merge
+  size_t bases[3];
+  size_t cornerBase;
+  /// Corners referencing elements that do not exist
+  size_t invalid;
+};
+
+inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+const char *SkipBlanks(const char *p, const char *end) {
+  while (p < end && IsBlank(*p))
+    p++;
+  return p;
+}
+
+/**
+ * @brief Reads a decimal number such as "-1.25e-3"
+ *
+ * Much faster than strtof, which also depends on the locale. Up to 18
+ * significant digits are kept, more than a float can hold.
+ */
+const char *ParseFloat(const char *p, const char *end, float &value) {
+  p = SkipBlanks(p, end);
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+
+  uint64_t digits = 0;
+  int significant = 0, exponent = 0;
+  for (; p < end && IsDigit(*p); p++) {
+    if (significant < 18) {
+      digits = digits * 10 + (*p - '0');
+      significant += digits != 0;
+    } else {
+      exponent++;
+    }
+  }
+  if (p < end && *p == '.') {
+    for (p++; p < end && IsDigit(*p); p++) {
+      if (significant < 18) {
+        digits = digits * 10 + (*p - '0');
+        significant += digits != 0;
+        exponent--;
+      }
+    }
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negativeExponent = *p++ == '-';
+    int written = 0;
+    for (; p < end && IsDigit(*p); p++)
+      written = std::min(written * 10 + (*p - '0'), 1000);
+    exponent += negativeExponent ? -written : written;
+  }
+
+  static const double POWERS[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  double result = static_cast<double>(digits);
+  if (exponent > 22 || exponent < -22)
+    result *= std::pow(10.0, exponent);
+  else if (exponent >= 0)
+    result *= POWERS[exponent];
+  else
+    result /= POWERS[-exponent];
+  value = static_cast<float>(negative ? -result : result);
+  return p;
+}
+
+/// Reads an optionally signed integer (0 if there are no digits)
+const char *ParseInt(const char *p, const char *end, long &value) {
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  value = 0;
+  for (; p < end && IsDigit(*p); p++)
+    value = value * 10 + (*p - '0');
+  if (negative)
+    value = -value;
+  return p;
+}
+
+/**
+ * @brief Reads one face corner ("v", "v/t", "v//n" or "v/t/n")
+ * @param counts Elements of each kind (position, normal, coordinate) read
+ * so far in this chunk, for relative indices
+ */
+const char *ParseCorner(const char *p, const char *end,
+                        const size_t counts[3], ChunkCorner &corner) {
+  long raw[3] = {0, 0, 0}; // As written: position, coordinate, normal
+  p = ParseInt(p, end, raw[0]);
+  if (p < end && *p == '/') {
+    p++;
+    if (p < end && *p != '/')
+      p = ParseInt(p, end, raw[1]);
+    if (p < end && *p == '/')
+      p = ParseInt(p + 1, end, raw[2]);
+  }
+
+  const long ordered[3] = {raw[0], raw[2], raw[1]};
+  corner.relative = 0;
+  for (int i = 0; i < 3; i++) {
+    if (ordered[i] > 0) {
+      corner.index[i] = static_cast<int>(ordered[i] - 1);
+    } else if (ordered[i] < 0) {
+      // May point before the chunk; the merge adds the earlier counts
+      corner.index[i] = static_cast<int>(static_cast<long>(counts[i]) +
+                                         ordered[i]);
+      corner.relative |= 1 << i;
+    } else {
+      corner.index[i] = -1;
+    }
+  }
+  return p;
+}
+
+/**
+ * @brief Parses the v, vn, vt and f lines of a chunk
+ */
+void ParseChunk(Chunk &chunk) {
+  std::vector<ChunkCorner> polygon;
+  const char *p = chunk.begin;
+  while (p < chunk.end) {
+    const char *lineEnd = static_cast<const char *>(
+        std::memchr(p, '\n', static_cast<size_t>(chunk.end - p)));
+    if (!lineEnd)
+      lineEnd = chunk.end;
+    p = SkipBlanks(p, lineEnd);
+
+    if (lineEnd - p >= 2 && p[0] == 'v' && IsBlank(p[1])) {
+      float value;
+      for (int i = 0; i < 3; i++) {
+        p = ParseFloat(p + (i == 0 ? 1 : 0), lineEnd, value);
+        chunk.positions.push_back(value);
+      }
+    } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' &&
+               IsBlank(p[2])) {
+      float value;
+      p += 2;
+      for (int i = 0; i < 3; i++) {
+        p = ParseFloat(p, lineEnd, value);
+        chunk.normals.push_back(value);
+      }
+    } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' &&
+               IsBlank(p[2])) {
+      float value;
+      p += 2;
+      for (int i = 0; i < 2; i++) {
+        p = ParseFloat(p, lineEnd, value);
+        chunk.texCoords.push_back(value);
+      }
+    } else if (lineEnd - p >= 2 && p[0] == 'f' && IsBlank(p[1])) {
+      const size_t counts[3] = {chunk.positions.size() / 3,
+                                chunk.normals.size() / 3,
+                                chunk.texCoords.size() / 2};
+      polygon.clear();
+      p++;
+      for (;;) {
+        p = SkipBlanks(p, lineEnd);
+        if (p >= lineEnd)
+          break;
+        ChunkCorner corner;
+        const char *next = ParseCorner(p, lineEnd, counts, corner);
+        if (next == p)
+          break; // Not a corner: ignore the rest of the line
+        polygon.push_back(corner);
+        p = next;
+        while (p < lineEnd && !IsBlank(*p))
+          p++;
+      }
+      // Fan triangulation (faces are convex in practice)
+      for (size_t i = 2; i < polygon.size(); i++) {
+        chunk.corners.push_back(polygon[0]);
+        chunk.corners.push_back(polygon[i - 1]);
+        chunk.corners.push_back(polygon[i]);
+      }
+    }
+    p = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+  }
+}
+
+/**
+ * @brief Copies a chunk into the merged arrays, fixing relative indices
+ */
+void MergeChunk(Chunk &chunk, ObjData &data) {
+  std::copy(chunk.positions.begin(), chunk.positions.end(),
+            data.Positions.begin() + chunk.bases[0] * 3);
+  std::copy(chunk.normals.begin(), chunk.normals.end(),
+            data.Normals.begin() + chunk.bases[1] * 3);
+  std::copy(chunk.texCoords.begin(), chunk.texCoords.end(),
+            data.TexCoords.begin() + chunk.bases[2] * 2);
+
+  const long totals[3] = {static_cast<long>(data.Positions.size() / 3),
+                          static_cast<long>(data.Normals.size() / 3),
+                          static_cast<long>(data.TexCoords.size() / 2)};
+  int *out = data.Corners.data() + chunk.cornerBase * 3;
+  for (const ChunkCorner &corner : chunk.corners) {
+    bool valid = true;
+    for (int i = 0; i < 3; i++) {
+      long index = corner.index[i];
+      if (corner.relative & (1 << i)) {
+        index += static_cast<long>(chunk.bases[i]);
+        valid = valid && index >= 0;
+      }
+      // Every corner needs a position; normals and coordinates are optional
+      if (index >= totals[i] || index < (i == 0 ? 0 : -1)) {
+        valid = false;
+        index = -1;
+      }
+      *out++ = static_cast<int>(index);
+    }
+    if (!valid)
+      chunk.invalid++;
+  }
+}
+
+/**
+ * @brief Runs a function on every chunk, one thread each
+ */
+void ForEachChunk(std::vector<Chunk> &chunks,
+                  const std::function<void(Chunk &)> &function) {
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < chunks.size(); i++)
+    threads.emplace_back(function, std::ref(chunks[i]));
+  function(chunks[0]); // The calling thread takes the first one
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+} // namespace
+
+/**
+ * @brief Splits the mapped file, parses the chunks, then merges them
+ */
+bool ObjParser::Parse(const std::string &path, ObjData &data) {
+  TRACE_SCOPE("ObjParser::Parse");
+  data = ObjData();
+
+  MappedFile file;
+  if (!file.Open(path)) {
+    std::cerr << "ERROR: Could not read OBJ file: " << path << std::endl;
+    return false;
+  }
+  const char *text = reinterpret_cast<const char *>(file.Data());
+  const char *end = text + file.Size();
+
+  size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  size_t count = std::max<size_t>(
+      1, std::min(cores, file.Size() / MIN_CHUNK));
+  std::vector<Chunk> chunks(count);
+  const char *begin = text;
+  for (size_t i = 0; i < count; i++) {
+    Chunk &chunk = chunks[i];
+    chunk.begin = begin;
+    chunk.end = end;
+    chunk.invalid = 0;
+    if (i + 1 < count) {
+      // Cut after the first line break at or past the even split point
+      const char *split =
+          std::max(begin, text + file.Size() * (i + 1) / count);
+      const char *lineBreak = static_cast<const char *>(
+          std::memchr(split, '\n', static_cast<size_t>(end - split)));
+      chunk.end = lineBreak ? lineBreak + 1 : end;
+    }
+    begin = chunk.end;
+  }
+
+  {
+    TRACE_SCOPE("ObjParser::ParseChunks");
+    ForEachChunk(chunks, ParseChunk);
+  }
+
+  // Each chunk's elements follow those of the chunks before it
+  size_t totals[3] = {0, 0, 0}, corners = 0;
+  for (Chunk &chunk : chunks) {
+    chunk.bases[0] = totals[0];
+    chunk.bases[1] = totals[1];
+    chunk.bases[2] = totals[2];
+    chunk.cornerBase = corners;
+    totals[0] += chunk.positions.size() / 3;
+    totals[1] += chunk.normals.size() / 3;
+    totals[2] += chunk.texCoords.size() / 2;
+    corners += chunk.corners.size();
+  }
+  data.Positions.resize(totals[0] * 3);
+  data.Normals.resize(totals[1] * 3);
+  data.TexCoords.resize(totals[2] * 2);
+  data.Corners.resize(corners * 3);
+
+  {
+    TRACE_SCOPE("ObjParser::Merge");
+    ForEachChunk(chunks, [&data](Chunk &chunk) { MergeChunk(chunk, data); });
+  }
+
+  size_t invalid = 0;
+  for (const Chunk &chunk : chunks)
+    invalid += chunk.invalid;
+  if (invalid > 0) {
+    std::cerr << "ERROR: " << invalid
+              << " face corners reference missing vertices in " << path
+              << std::endl;
+    return false;
+  }
+  return true;
+}
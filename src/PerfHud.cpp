@@ -0,0 +1,112 @@
+/**
+ * @file PerfHud.cpp
+ * @brief Implementation of the PerfHud class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/PerfHud.h"
+#include "../include/TextRenderer.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+/// Weight of a new sample in the moving average
+const float SMOOTHING = 0.1f;
+
+const char *CPU_PHASE_NAMES[PerfHud::CPU_PHASE_COUNT] = {
+    "input", "update", "render", "minimap", "ui"};
+const char *GPU_PASS_NAMES[PerfHud::GPU_PASS_COUNT] = {"scene", "minimap",
+                                                       "ui"};
+
+} // namespace
+
+/**
+ * @brief Creates the GPU timers (requires a current GL context)
+ */
+PerfHud::PerfHud()
+    : lastRefresh(-1.0e9), resolutionScale(1.0f), depthPrepass(false),
+      textureBytes(0), textureBudget(0) {
+  for (int i = 0; i < CPU_PHASE_COUNT; i++)
+    cpuMilliseconds[i] = 0.0f;
+}
+
+/**
+ * @brief Monotonic time in milliseconds
+ */
+double PerfHud::Now() {
+  using namespace std::chrono;
+  return duration<double, std::milli>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief Blends a new sample into a phase's moving average
+ */
+void PerfHud::RecordCpu(CpuPhase phase, double milliseconds) {
+  float previous = cpuMilliseconds[phase].load(std::memory_order_relaxed);
+  float smoothed =
+      previous + (static_cast<float>(milliseconds) - previous) * SMOOTHING;
+  cpuMilliseconds[phase].store(smoothed, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Keeps the finished frame's counters and polls the GPU timers
+ */
+void PerfHud::BeginFrame() {
+  lastFrame = RenderStats::Current();
+  RenderStats::Current() = RenderStats();
+  for (GpuTimer &timer : gpuTimers)
+    timer.Poll();
+}
+
+/**
+ * @brief Refreshes the text if it is due and draws it
+ */
+void PerfHud::Draw(TextRenderer &renderer, unsigned int width,
+                   unsigned int height) {
+  double now = Now();
+  if (now - lastRefresh >= 1000.0 / REFRESH_RATE) {
+    lastRefresh = now;
+    char line[160];
+    int length;
+
+    length = snprintf(line, sizeof(line), "CPU ms");
+    for (int i = 0; i < CPU_PHASE_COUNT; i++) {
+      length += snprintf(line + length, sizeof(line) - length, "  %s %.2f",
+                         CPU_PHASE_NAMES[i], cpuMilliseconds[i].load());
+    }
+    layout.SetLine(0, line, 10.0f, height - 24.0f, 0.6f,
+                   glm::vec3(1.0f, 0.9f, 0.3f), TextLayout::Align::LEFT);
+
+    length = snprintf(line, sizeof(line), "GPU ms");
+    for (int i = 0; i < GPU_PASS_COUNT; i++) {
+      length += snprintf(line + length, sizeof(line) - length, "  %s %.2f",
+                         GPU_PASS_NAMES[i], gpuTimers[i].LastMilliseconds());
+    }
+    layout.SetLine(1, line, 10.0f, height - 44.0f, 0.6f,
+                   glm::vec3(1.0f, 0.9f, 0.3f), TextLayout::Align::LEFT);
+
+    snprintf(line, sizeof(line),
+             "draws %u  triangles %u  state changes %u (saved %u)  "
+             "scene scale %.0f%%  prepass %s",
+             lastFrame.drawCalls, lastFrame.triangles, lastFrame.stateChanges,
+             lastFrame.savedCalls, resolutionScale * 100.0f,
+             depthPrepass ? "on" : "off");
+    layout.SetLine(2, line, 10.0f, height - 64.0f, 0.6f,
+                   glm::vec3(1.0f, 0.9f, 0.3f), TextLayout::Align::LEFT);
+
+    length = snprintf(line, sizeof(line), "textures %.1f MB",
+                      textureBytes / (1024.0 * 1024.0));
+    if (textureBudget > 0) {
+      snprintf(line + length, sizeof(line) - length, " / %.0f MB budget",
+               textureBudget / (1024.0 * 1024.0));
+    }
+    layout.SetLine(3, line, 10.0f, height - 84.0f, 0.6f,
+                   glm::vec3(1.0f, 0.9f, 0.3f), TextLayout::Align::LEFT);
+  }
+
+  layout.SetViewport(width, height);
+  layout.Draw(renderer);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of the RenderQueue class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/RenderQueue.h"
+#include "../include/GLStateCache.h"
+#include "../include/Mesh.hpp"
+#include "../include/Shader.h"
+#include "../include/Trace.h"
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+const char *DEPTH_VERTEX_SHADER = R"(
+  #version 330 core
+  layout (location = 0) in vec3 aPos;
+  invariant gl_Position;
+  uniform mat4 model;
+  uniform mat4 view;
+  uniform mat4 projection;
+  void main() {
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+  }
+)";
+
+const char *DEPTH_FRAGMENT_SHADER = R"(
+  #version 330 core
+  void main() {}
+)";
+
+} // namespace
+
+RenderQueue::RenderQueue() : depthShader(nullptr) {}
+
+RenderQueue::~RenderQueue() {
+  if (depthShader) {
+    glDeleteProgram(depthShader->ID);
+    delete depthShader;
+  }
+}
+
+void RenderQueue::Clear() {
+  items.clear();
+  keys.clear();
+  order.clear();
+}
+
+void RenderQueue::Submit(unsigned int pass, Shader &shader, Mesh &mesh,
+                         const glm::mat4 &model, const glm::vec3 &color,
+                         float viewDepth) {
+  unsigned int material = mesh.textures.empty() ? 0 : mesh.textures[0].id;
+  keys.push_back(MakeKey(pass, shader.ID, material, viewDepth));
+  order.push_back(static_cast<uint32_t>(items.size()));
+  items.push_back(Item{&shader, &mesh, model, color});
+}
+
+/**
+ * @brief LSD radix sort of the item indices, one byte of the key per pass
+ */
+void RenderQueue::Sort() {
+  TRACE_SCOPE("RenderQueue::Sort");
+  const size_t count = order.size();
+  if (count < 2)
+    return;
+
+  // Histograms of all eight digits in a single pass over the keys
+  uint32_t histograms[8][256];
+  std::memset(histograms, 0, sizeof(histograms));
+  for (size_t i = 0; i < count; i++) {
+    uint64_t key = keys[i];
+    for (int digit = 0; digit < 8; digit++)
+      histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+  }
+
+  scratch.resize(count);
+  for (int digit = 0; digit < 8; digit++) {
+    uint32_t *histogram = histograms[digit];
+    int shift = digit * 8;
+    // Every key has the same byte here: the pass would not move anything
+    if (histogram[(keys[0] >> shift) & 0xFF] == count)
+      continue;
+
+    uint32_t offset = 0;
+    for (int bucket = 0; bucket < 256; bucket++) {
+      uint32_t size = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += size;
+    }
+    for (size_t i = 0; i < count; i++) {
+      uint32_t index = order[i];
+      scratch[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+    }
+    order.swap(scratch);
+  }
+}
+
+void RenderQueue::Execute() const {
+  TRACE_SCOPE("RenderQueue::Execute");
+  for (uint32_t index : order) {
+    const Item &item = items[index];
+    Shader &shader = *item.shader;
+    shader.use(); // Skipped by the state cache while the program repeats
+    shader.setMat4("model", glm::value_ptr(item.model));
+    shader.setVec3("objectColor", item.color.x, item.color.y, item.color.z);
+    item.mesh->Draw(shader.ID);
+  }
+}
+
+/**
+ * @brief Depth pre-pass: same order, geometry only, no color writes
+ */
+void RenderQueue::ExecuteDepthOnly(const glm::mat4 &view,
+                                   const glm::mat4 &projection) {
+  TRACE_SCOPE("RenderQueue::ExecuteDepthOnly");
+  if (!depthShader)
+    depthShader = new Shader("DepthPrepass", DEPTH_VERTEX_SHADER,
+                             DEPTH_FRAGMENT_SHADER);
+
+  GLStateCache &state = GLStateCache::Get();
+  state.ColorMask(false);
+  depthShader->use();
+  depthShader->setMat4("view", glm::value_ptr(view));
+  depthShader->setMat4("projection", glm::value_ptr(projection));
+  GLint modelLocation = glGetUniformLocation(depthShader->ID, "model");
+  for (uint32_t index : order) {
+    const Item &item = items[index];
+    glUniformMatrix4fv(modelLocation, 1, GL_FALSE,
+                       glm::value_ptr(item.model));
+    item.mesh->DrawGeometry();
+  }
+  state.ColorMask(true);
+}
+
+uint64_t RenderQueue::MakeKey(unsigned int pass, unsigned int program,
+                              unsigned int material, float viewDepth) {
+  // Non-negative IEEE floats compare like their bit patterns
+  float depth = viewDepth > 0.0f ? viewDepth : 0.0f;
+  uint32_t depthBits;
+  std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+  return (static_cast<uint64_t>(pass & 0xF) << 60) |
+         (static_cast<uint64_t>(program & 0xFFF) << 48) |
+         (static_cast<uint64_t>(material & 0xFFFF) << 32) | depthBits;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file ShaderCache.cpp
+ * @brief Implementation of the ShaderCache class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/ShaderCache.h"
+#include "../include/AssetCache.h"
+#include "../include/Trace.h"
+#include "glad/glad.h"
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+/// Identifies program binary files ("SHBC")
+const uint32_t PROGRAM_CACHE_MAGIC = 0x43424853;
+/// Bump when the file layout changes
+const uint32_t PROGRAM_CACHE_VERSION = 1;
+
+/**
+ * @brief Hash of the driver identity (computed once per run)
+ */
+uint64_t DriverHash() {
+  static uint64_t hash = 0;
+  if (hash == 0) {
+    hash = AssetCache::HASH_SEED;
+    const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (GLenum name : names) {
+      const char *value =
+          reinterpret_cast<const char *>(glGetString(name));
+      hash = AssetCache::Hash(value ? value : "", hash);
+      hash = AssetCache::Hash("|", hash); // Separator
+    }
+  }
+  return hash;
+}
+
+/**
+ * @brief True if the driver can save and load program binaries
+ */
+bool BinariesSupported() {
+  static int supported = -1;
+  if (supported < 0) {
+    GLint formats = 0;
+    if (GLAD_GL_ARB_get_program_binary)
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    supported = formats > 0 ? 1 : 0;
+  }
+  return supported == 1;
+}
+
+/**
+ * @brief Compiles one shader stage, printing the log on failure
+ */
+unsigned int CompileStage(GLenum type, const std::string &source,
+                          const std::string &label) {
+  const char *code = source.c_str();
+  unsigned int shader = glCreateShader(type);
+  glShaderSource(shader, 1, &code, NULL);
+  glCompileShader(shader);
+
+  int success;
+  char infoLog[1024];
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+  if (!success) {
+    glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+    std::cerr << "ERROR: " << label << " Shader Compilation Failed\n"
+              << infoLog << std::endl;
+  }
+  return shader;
+}
+
+} // namespace
+
+/**
+ * @brief Creates a program, from the binary cache when possible
+ */
+unsigned int ShaderCache::BuildProgram(const std::string &name,
+                                       const std::string &vertexSource,
+                                       const std::string &fragmentSource) {
+  TRACE_SCOPE("ShaderCache::BuildProgram");
+
+  if (!BinariesSupported())
+    return Compile(name, vertexSource, fragmentSource);
+
+  // Length-prefix the sources so moving text between stages changes the key
+  uint64_t key = DriverHash();
+  uint64_t lengths[2] = {vertexSource.size(), fragmentSource.size()};
+  key = AssetCache::Hash(lengths, sizeof(lengths), key);
+  key = AssetCache::Hash(vertexSource, key);
+  key = AssetCache::Hash(fragmentSource, key);
+  std::string path = AssetCache::PathFor("shaders", key, ".bin");
+
+  unsigned int program = LoadBinary(path);
+  if (program != 0)
+    return program;
+
+  program = Compile(name, vertexSource, fragmentSource);
+  SaveBinary(path, program);
+  return program;
+}
+
+/**
+ * @brief Loads a cached program binary
+ * @param path Cache file
+ * @return Linked program, or 0 if the file is missing or was rejected
+ */
+unsigned int ShaderCache::LoadBinary(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return 0;
+
+  uint32_t header[4]; // magic, version, binary format, binary length
+  file.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!file || header[0] != PROGRAM_CACHE_MAGIC ||
+      header[1] != PROGRAM_CACHE_VERSION || header[3] == 0)
+    return 0;
+
+  std::vector<char> binary(header[3]);
+  file.read(binary.data(), binary.size());
+  if (!file)
+    return 0;
+
+  unsigned int program = glCreateProgram();
+  glProgramBinary(program, header[2], binary.data(),
+                  static_cast<GLsizei>(binary.size()));
+
+  // Drivers may refuse binaries even for the same renderer string
+  int success;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (!success) {
+    glDeleteProgram(program);
+    return 0;
+  }
+  return program;
+}
+
+/**
+ * @brief Stores the binary of a linked program
+ * @param path Cache file
+ * @param program Program linked with the retrievable hint
+ */
+void ShaderCache::SaveBinary(const std::string &path, unsigned int program) {
+  int success = 0, length = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (!success || length <= 0)
+    return;
+
+  std::vector<char> binary(length);
+  GLenum format = 0;
+  glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    std::cout << "WARNING: Could not write shader cache: " << path
+              << std::endl;
+    return;
+  }
+  uint32_t header[4] = {PROGRAM_CACHE_MAGIC, PROGRAM_CACHE_VERSION, format,
+                        static_cast<uint32_t>(length)};
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file.write(binary.data(), binary.size());
+}
+
+/**
+ * @brief Compiles and links a program from source
+ */
+unsigned int ShaderCache::Compile(const std::string &name,
+                                  const std::string &vertexSource,
+                                  const std::string &fragmentSource) {
+  unsigned int vertex =
+      CompileStage(GL_VERTEX_SHADER, vertexSource, name + " Vertex");
+  unsigned int fragment =
+      CompileStage(GL_FRAGMENT_SHADER, fragmentSource, name + " Fragment");
+
+  unsigned int program = glCreateProgram();
+  glAttachShader(program, vertex);
+  glAttachShader(program, fragment);
+  if (BinariesSupported())
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glLinkProgram(program);
+
+  int success;
+  char infoLog[1024];
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (!success) {
+    glGetProgramInfoLog(program, 1024, NULL, infoLog);
+    std::cerr << "ERROR: " << name << " Shader Program Linking Failed\n"
+              << infoLog << std::endl;
+  }
+
+  // Delete shaders (already linked)
+  glDeleteShader(vertex);
+  glDeleteShader(fragment);
+  return program;
+}
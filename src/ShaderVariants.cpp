@@ -0,0 +1,107 @@
+/**
+ * @file ShaderVariants.cpp
+ * @brief Implementation of the ShaderVariants class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/ShaderVariants.h"
+#include "../include/Shader.h"
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief Reads a whole text file, printing an error on failure
+ */
+std::string ReadSource(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cout << "ERROR: Shader file not read successfully: " << path
+              << std::endl;
+    return std::string();
+  }
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+/**
+ * @brief Inserts text right after the #version line (which must stay the
+ * first directive), or at the start if there is none
+ */
+void InsertAfterVersion(std::string &source, const std::string &text) {
+  size_t version = source.find("#version");
+  size_t insertAt = 0;
+  if (version != std::string::npos) {
+    insertAt = source.find('\n', version);
+    insertAt = insertAt == std::string::npos ? source.size() : insertAt + 1;
+  }
+  source.insert(insertAt, text);
+}
+
+} // namespace
+
+ShaderVariants::ShaderVariants(const std::string &vertexPath,
+                               const std::string &fragmentPath,
+                               const std::vector<Feature> &features)
+    : name(fragmentPath), vertexSource(ReadSource(vertexPath)),
+      fragmentSource(ReadSource(fragmentPath)), features(features) {}
+
+/**
+ * @brief Deletes every program that was built
+ */
+ShaderVariants::~ShaderVariants() {
+  for (auto &entry : programs) {
+    glDeleteProgram(entry.second->ID);
+    delete entry.second;
+  }
+}
+
+/**
+ * @brief Looks up a variant, compiling it on first use
+ */
+Shader &ShaderVariants::Get(unsigned int mask) {
+  auto found = programs.find(mask);
+  if (found != programs.end())
+    return *found->second;
+
+  // Same depths as the depth pre-pass, which the GL_EQUAL shading relies on
+  std::string vertex = Specialize(vertexSource, features, mask);
+  if (vertex.find("invariant gl_Position") == std::string::npos)
+    InsertAfterVersion(vertex, "invariant gl_Position;\n");
+  Shader *shader =
+      new Shader(name + " [variant " + std::to_string(mask) + "]", vertex,
+                 Specialize(fragmentSource, features, mask));
+  programs[mask] = shader;
+  return *shader;
+}
+
+/**
+ * @brief Inserts the defines after #version and turns the feature uniforms
+ * into constants
+ */
+std::string ShaderVariants::Specialize(const std::string &source,
+                                       const std::vector<Feature> &features,
+                                       unsigned int mask) {
+  std::string defines;
+  std::string result = source;
+  for (size_t i = 0; i < features.size(); i++) {
+    bool enabled = (mask >> i) & 1u;
+    defines += std::string("#define ") + features[i].define +
+               (enabled ? " 1\n" : " 0\n");
+
+    std::regex declaration(std::string("uniform\\s+bool\\s+") +
+                           features[i].uniform + "\\s*;");
+    result = std::regex_replace(
+        result, declaration,
+        std::string("const bool ") + features[i].uniform +
+            (enabled ? " = true;" : " = false;"));
+  }
+
+  InsertAfterVersion(result, defines);
+  return result;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file SignedDistanceField.cpp
+ * @brief Implementation of the signed distance field generator (8SSEDT)
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/SignedDistanceField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Offset to the nearest seed pixel
+struct Offset {
+  int dx, dy;
+  int Dist2() const { return dx * dx + dy * dy; }
+};
+
+const Offset FAR_AWAY = {9999, 9999};
+
+/**
+ * @brief Takes the neighbour's nearest seed if it is closer than ours
+ */
+inline void Compare(std::vector<Offset> &grid, int width, int height, int x,
+                    int y, int ox, int oy) {
+  int nx = x + ox, ny = y + oy;
+  if (nx < 0 || nx >= width || ny < 0 || ny >= height)
+    return;
+  Offset other = grid[ny * width + nx];
+  other.dx += ox;
+  other.dy += oy;
+  Offset &self = grid[y * width + x];
+  if (other.Dist2() < self.Dist2())
+    self = other;
+}
+
+/**
+ * @brief Two-pass 8-point sequential Euclidean distance transform
+ */
+void Propagate(std::vector<Offset> &grid, int width, int height) {
+  // Top to bottom
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      Compare(grid, width, height, x, y, -1, 0);
+      Compare(grid, width, height, x, y, 0, -1);
+      Compare(grid, width, height, x, y, -1, -1);
+      Compare(grid, width, height, x, y, 1, -1);
+    }
+    for (int x = width - 1; x >= 0; x--) {
+      Compare(grid, width, height, x, y, 1, 0);
+    }
+  }
+
+  // Bottom to top
+  for (int y = height - 1; y >= 0; y--) {
+    for (int x = width - 1; x >= 0; x--) {
+      Compare(grid, width, height, x, y, 1, 0);
+      Compare(grid, width, height, x, y, 0, 1);
+      Compare(grid, width, height, x, y, -1, 1);
+      Compare(grid, width, height, x, y, 1, 1);
+    }
+    for (int x = 0; x < width; x++) {
+      Compare(grid, width, height, x, y, -1, 0);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<unsigned char>
+GenerateSignedDistanceField(const std::vector<unsigned char> &bitmap,
+                            int width, int height, int downscale,
+                            float spread) {
+  // toInside: distance from outside pixels to the shape
+  // toOutside: distance from inside pixels to the background
+  std::vector<Offset> toInside(static_cast<size_t>(width) * height);
+  std::vector<Offset> toOutside(static_cast<size_t>(width) * height);
+  for (size_t i = 0; i < bitmap.size(); i++) {
+    bool inside = bitmap[i] >= 128;
+    toInside[i] = inside ? Offset{0, 0} : FAR_AWAY;
+    toOutside[i] = inside ? FAR_AWAY : Offset{0, 0};
+  }
+  Propagate(toInside, width, height);
+  Propagate(toOutside, width, height);
+
+  int outWidth = width / downscale;
+  int outHeight = height / downscale;
+  std::vector<unsigned char> field(static_cast<size_t>(outWidth) * outHeight);
+
+  for (int y = 0; y < outHeight; y++) {
+    for (int x = 0; x < outWidth; x++) {
+      int sx = x * downscale + downscale / 2;
+      int sy = y * downscale + downscale / 2;
+      size_t i = static_cast<size_t>(sy) * width + sx;
+
+      // Positive inside, in output pixels
+      float distance = (std::sqrt((float)toOutside[i].Dist2()) -
+                        std::sqrt((float)toInside[i].Dist2())) /
+                       downscale;
+      float value = 0.5f + distance / (2.0f * spread);
+      value = std::min(1.0f, std::max(0.0f, value));
+      field[static_cast<size_t>(y) * outWidth + x] =
+          static_cast<unsigned char>(value * 255.0f + 0.5f);
+    }
+  }
+  return field;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file TextLayout.cpp
+ * @brief Implementation of the TextLayout class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/TextLayout.h"
+#include "../include/GLStateCache.h"
+#include "../include/TextRenderer.h"
+
+/**
+ * @brief Constructs an empty layout (GL buffers are created on first draw)
+ */
+TextLayout::TextLayout()
+    : viewportWidth(0), viewportHeight(0), dirty(true), builtGeneration(0),
+      VAO(0), VBO(0), vertexCount(0) {}
+
+/**
+ * @brief Frees the cached vertex buffer
+ */
+TextLayout::~TextLayout() {
+  if (VBO != 0)
+    GLStateCache::Get().DeleteBuffers(1, &VBO);
+  if (VAO != 0)
+    GLStateCache::Get().DeleteVertexArrays(1, &VAO);
+}
+
+/**
+ * @brief Sets the viewport, invalidating the geometry if it changed
+ */
+void TextLayout::SetViewport(unsigned int width, unsigned int height) {
+  if (width != viewportWidth || height != viewportHeight) {
+    viewportWidth = width;
+    viewportHeight = height;
+    dirty = true;
+  }
+}
+
+/**
+ * @brief Sets a line, invalidating the geometry only if it changed
+ */
+void TextLayout::SetLine(size_t index, const char *text, float x, float y,
+                         float scale, glm::vec3 color, Align align) {
+  if (index >= lines.size()) {
+    lines.resize(index + 1, Line{"", 0.0f, 0.0f, 1.0f, glm::vec3(1.0f),
+                                 Align::LEFT, 0.0f});
+    dirty = true;
+  }
+
+  Line &line = lines[index];
+  if (line.text != text) {
+    line.text = text;
+    dirty = true;
+  }
+  if (line.x != x || line.y != y || line.scale != scale ||
+      line.color != color || line.align != align) {
+    line.x = x;
+    line.y = y;
+    line.scale = scale;
+    line.color = color;
+    line.align = align;
+    dirty = true;
+  }
+}
+
+/**
+ * @brief Drops the lines past the given count
+ */
+void TextLayout::Truncate(size_t count) {
+  if (count < lines.size()) {
+    lines.resize(count);
+    dirty = true;
+  }
+}
+
+/**
+ * @brief Width of a line in pixels
+ */
+float TextLayout::GetLineWidth(size_t index) const {
+  return index < lines.size() ? lines[index].width : 0.0f;
+}
+
+/**
+ * @brief Draws the cached geometry with a single draw call
+ */
+void TextLayout::Draw(TextRenderer &renderer) {
+  if (dirty || builtGeneration != renderer.Generation())
+    Rebuild(renderer);
+
+  renderer.DrawVertices(VAO, vertexCount);
+}
+
+/**
+ * @brief Shapes every line into quads and uploads them
+ */
+void TextLayout::Rebuild(TextRenderer &renderer) {
+  std::vector<float> vertices;
+  for (Line &line : lines) {
+    line.width = renderer.CalculateTextWidth(line.text, line.scale);
+    float x = (line.align == Align::CENTER)
+                  ? (viewportWidth - line.width) / 2.0f
+                  : line.x;
+    renderer.AppendQuads(vertices, line.text, x, line.y, line.scale,
+                         line.color);
+  }
+
+  GLStateCache &state = GLStateCache::Get();
+  if (VAO == 0) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    state.BindVertexArray(VAO);
+    state.BindBuffer(GL_ARRAY_BUFFER, VBO);
+    TextRenderer::ConfigureVertexAttributes();
+  }
+
+  state.BindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
+               vertices.empty() ? NULL : vertices.data(), GL_STATIC_DRAW);
+
+  vertexCount =
+      static_cast<int>(vertices.size() / TextRenderer::FLOATS_PER_VERTEX);
+  builtGeneration = renderer.Generation();
+  dirty = false;
+}
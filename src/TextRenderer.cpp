@@ -6,6 +6,14 @@
  */
 
 #include "../include/TextRenderer.h"
+#include "../include/AssetCache.h"
+#include "../include/GLStateCache.h"
+#include "../include/RenderStats.h"
+#include "../include/ShaderCache.h"
+#include "../include/SignedDistanceField.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <fstream>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <iostream>
 
@@ -14,186 +22,630 @@
  * @param width Screen width
  * @param height Screen height
  */
-TextRenderer::TextRenderer(unsigned int width, unsigned int height) {
+TextRenderer::TextRenderer(unsigned int width, unsigned int height)
+    : AtlasTexture(0), generation(0), fontSize(0), fontKey(0), ft(nullptr),
+      face(nullptr), shelfHeight(0), batchStamp(1), VAO(0), VBO(0),
+      bufferCapacity(0) {
   // Load and configure shader
   const char *vertexShaderSource = R"(
     #version 330 core
     layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+    layout (location = 1) in vec3 color;
     out vec2 TexCoords;
+    out vec3 TextColor;
     uniform mat4 projection;
     void main() {
       gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
       TexCoords = vertex.zw;
+      TextColor = color;
     }
   )";
 
   const char *fragmentShaderSource = R"(
     #version 330 core
     in vec2 TexCoords;
+    in vec3 TextColor;
     out vec4 color;
     uniform sampler2D text;
-    uniform vec3 textColor;
     void main() {
-      vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-      color = vec4(textColor, 1.0) * sampled;
+      // The atlas stores signed distances (0.5 = glyph edge). Antialias over
+      // one screen pixel whatever the scale the text is drawn at.
+      float dist = texture(text, TexCoords).r;
+      float width = max(fwidth(dist), 1e-4);
+      float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+      color = vec4(TextColor, alpha);
     }
   )";
 
-  // Compile shaders
-  unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-  glCompileShader(vertexShader);
+  // Compile and link (or reuse the cached binary)
+  this->TextShader = ShaderCache::BuildProgram("Text", vertexShaderSource,
+                                               fragmentShaderSource);
 
-  unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-  glCompileShader(fragmentShader);
-
-  // Link shaders
-  this->TextShader = glCreateProgram();
-  glAttachShader(this->TextShader, vertexShader);
-  glAttachShader(this->TextShader, fragmentShader);
-  glLinkProgram(this->TextShader);
-
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
-
-  // Configure VAO/VBO for texture quads
+  // Configure VAO/VBO for the glyph batch (storage is allocated on Flush)
+  GLStateCache &state = GLStateCache::Get();
   glGenVertexArrays(1, &this->VAO);
   glGenBuffers(1, &this->VBO);
-  glBindVertexArray(this->VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
+  state.BindVertexArray(this->VAO);
+  state.BindBuffer(GL_ARRAY_BUFFER, this->VBO);
+  ConfigureVertexAttributes();
 
   // Set projection matrix (orthographic for 2D text rendering)
   glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f,
                                     static_cast<float>(height));
-  glUseProgram(this->TextShader);
+  state.UseProgram(this->TextShader);
   glUniformMatrix4fv(glGetUniformLocation(this->TextShader, "projection"), 1,
                      GL_FALSE, &projection[0][0]);
+  glUniform1i(glGetUniformLocation(this->TextShader, "text"), 0);
+
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    Characters[i] = Character{glm::ivec2(0), glm::ivec2(0), 0, glm::vec2(0.0f),
+                              glm::vec2(0.0f), false, -1};
+  }
 }
 
 /**
- * @brief Pre-compiles a list of characters from the given font
- * @param font Path to the font file
- * @param fontSize Size of the font to load
+ * @brief Frees the atlas, shader, buffers and the FreeType face
  */
-void TextRenderer::Load(std::string font, unsigned int fontSize) {
-  // Clear any previously loaded characters
-  this->Characters.clear();
+TextRenderer::~TextRenderer() {
+  CloseFace();
+  GLStateCache &state = GLStateCache::Get();
+  if (AtlasTexture != 0)
+    state.DeleteTextures(1, &AtlasTexture);
+  if (VBO != 0)
+    state.DeleteBuffers(1, &VBO);
+  if (VAO != 0)
+    state.DeleteVertexArrays(1, &VAO);
+  if (TextShader != 0)
+    glDeleteProgram(TextShader);
+}
+
+// ============================================================================
+// SDF glyph generation and disk cache
+// ============================================================================
+
+namespace {
+
+/// Identifies glyph cache files ("SDFC")
+const uint32_t GLYPH_CACHE_MAGIC = 0x43464453;
+/// Bump when the cache layout or the SDF encoding changes
+const uint32_t GLYPH_CACHE_VERSION = 2;
+
+/**
+ * @brief Reads one glyph from its cache file
+ * @return false if the file is missing, stale or truncated
+ */
+bool ReadGlyphCache(const std::string &path, uint32_t codepoint,
+                    TextRenderer::GlyphBitmap &glyph) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+
+  uint32_t header[3];
+  file.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!file || header[0] != GLYPH_CACHE_MAGIC ||
+      header[1] != GLYPH_CACHE_VERSION || header[2] != codepoint)
+    return false;
+
+  int32_t fields[5];
+  file.read(reinterpret_cast<char *>(fields), sizeof(fields));
+  if (!file || fields[0] < 0 || fields[1] < 0)
+    return false;
+  glyph.Size = glm::ivec2(fields[0], fields[1]);
+  glyph.Bearing = glm::ivec2(fields[2], fields[3]);
+  glyph.Advance = static_cast<unsigned int>(fields[4]);
+  glyph.Pixels.resize(static_cast<size_t>(fields[0]) * fields[1]);
+  file.read(reinterpret_cast<char *>(glyph.Pixels.data()),
+            glyph.Pixels.size());
+  return static_cast<bool>(file);
+}
+
+/**
+ * @brief Writes one glyph to its cache file
+ */
+void WriteGlyphCache(const std::string &path, uint32_t codepoint,
+                     const TextRenderer::GlyphBitmap &glyph) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    std::cout << "WARNING: Could not write glyph cache: " << path << std::endl;
+    return;
+  }
+
+  uint32_t header[3] = {GLYPH_CACHE_MAGIC, GLYPH_CACHE_VERSION, codepoint};
+  int32_t fields[5] = {glyph.Size.x, glyph.Size.y, glyph.Bearing.x,
+                       glyph.Bearing.y, static_cast<int32_t>(glyph.Advance)};
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(fields), sizeof(fields));
+  file.write(reinterpret_cast<const char *>(glyph.Pixels.data()),
+             glyph.Pixels.size());
+}
+
+/**
+ * @brief Decodes the UTF-8 sequence starting at text[i] and advances i
+ *
+ * Malformed sequences decode to U+FFFD (replacement character) and consume
+ * a single byte, so decoding always makes progress.
+ */
+uint32_t DecodeUtf8(const std::string &text, size_t &i) {
+  const uint32_t REPLACEMENT = 0xFFFD;
+  unsigned char lead = static_cast<unsigned char>(text[i++]);
+  if (lead < 0x80)
+    return lead;
+
+  int length;
+  uint32_t codepoint;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 1;
+    codepoint = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 2;
+    codepoint = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 3;
+    codepoint = lead & 0x07;
+  } else {
+    return REPLACEMENT;
+  }
+
+  if (i + length > text.size())
+    return REPLACEMENT;
+  for (int k = 0; k < length; k++) {
+    unsigned char next = static_cast<unsigned char>(text[i + k]);
+    if ((next & 0xC0) != 0x80)
+      return REPLACEMENT;
+    codepoint = (codepoint << 6) | (next & 0x3F);
+  }
+  i += length;
+
+  // Reject overlong encodings, surrogates and out of range values
+  static const uint32_t MIN_VALUE[4] = {0, 0x80, 0x800, 0x10000};
+  if (codepoint < MIN_VALUE[length] || codepoint > 0x10FFFF ||
+      (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+    return REPLACEMENT;
+  return codepoint;
+}
+
+} // namespace
+
+/**
+ * @brief Rasterizes one glyph at SDF_UPSCALE times the font size and turns
+ * it into a distance field at the font size
+ * @param face FreeType face, already sized to fontSize * SDF_UPSCALE
+ * @param codepoint Character to rasterize
+ * @param out Resulting glyph (empty on failure or for whitespace)
+ * @return false if FreeType could not load the glyph
+ */
+bool TextRenderer::RasterizeGlyph(FT_Face face, unsigned long codepoint,
+                                  GlyphBitmap &out) {
+  out = GlyphBitmap{glm::ivec2(0), glm::ivec2(0), 0, {}};
+  if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER))
+    return false;
+
+  FT_GlyphSlot glyph = face->glyph;
+  // Advance in 26.6 fixed point at the base size
+  out.Advance = static_cast<unsigned int>(glyph->advance.x / SDF_UPSCALE);
+
+  int w = static_cast<int>(glyph->bitmap.width);
+  int h = static_cast<int>(glyph->bitmap.rows);
+  if (w == 0 || h == 0)
+    return true;
+
+  // Place the bitmap on a canvas with room for the spread on every side. The
+  // canvas origin is snapped to a multiple of SDF_UPSCALE so each output texel
+  // maps to a whole block of high-resolution pixels.
+  const int margin = SDF_SPREAD * SDF_UPSCALE;
+  auto floorDiv = [](int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+  };
+  int left = floorDiv(glyph->bitmap_left - margin, SDF_UPSCALE);
+  int top = -floorDiv(-(glyph->bitmap_top + margin), SDF_UPSCALE);
+  int right = -floorDiv(-(glyph->bitmap_left + w + margin), SDF_UPSCALE);
+  int bottom = floorDiv(glyph->bitmap_top - h - margin, SDF_UPSCALE);
+
+  int outW = right - left;
+  int outH = top - bottom;
+  int canvasW = outW * SDF_UPSCALE;
+  int canvasH = outH * SDF_UPSCALE;
+  int offsetX = glyph->bitmap_left - left * SDF_UPSCALE;
+  int offsetY = top * SDF_UPSCALE - glyph->bitmap_top;
+
+  std::vector<unsigned char> canvas(static_cast<size_t>(canvasW) * canvasH, 0);
+  for (int row = 0; row < h; row++) {
+    std::copy_n(glyph->bitmap.buffer + row * glyph->bitmap.pitch, w,
+                &canvas[static_cast<size_t>(row + offsetY) * canvasW + offsetX]);
+  }
+
+  out.Size = glm::ivec2(outW, outH);
+  out.Bearing = glm::ivec2(left, top);
+  out.Pixels = GenerateSignedDistanceField(canvas, canvasW, canvasH,
+                                           SDF_UPSCALE,
+                                           static_cast<float>(SDF_SPREAD));
+  return true;
+}
+
+/**
+ * @brief Opens the font with FreeType (only needed on a glyph cache miss)
+ * @return true if the face is ready
+ */
+bool TextRenderer::OpenFace() {
+  if (face)
+    return true;
+  if (fontPath.empty())
+    return false;
 
   // Initialize FreeType
-  FT_Library ft;
   if (FT_Init_FreeType(&ft)) {
     std::cout << "ERROR::FREETYPE: Could not init FreeType Library"
               << std::endl;
-    return;
+    ft = nullptr;
+    return false;
   }
 
   // Load font as face
-  FT_Face face;
-  if (FT_New_Face(ft, font.c_str(), 0, &face)) {
-    std::cout << "ERROR::FREETYPE: Failed to load font: " << font << std::endl;
-    return;
+  if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
+    std::cout << "ERROR::FREETYPE: Failed to load font: " << fontPath
+              << std::endl;
+    FT_Done_FreeType(ft);
+    ft = nullptr;
+    face = nullptr;
+    fontPath.clear(); // Do not retry for every glyph
+    return false;
   }
 
-  // Set size to load glyphs as
-  FT_Set_Pixel_Sizes(face, 0, fontSize);
+  // Rasterize at a higher resolution than the field is stored at
+  FT_Set_Pixel_Sizes(face, 0, fontSize * SDF_UPSCALE);
+  return true;
+}
 
-  // Disable byte-alignment restriction
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+/**
+ * @brief Releases the FreeType face and library
+ */
+void TextRenderer::CloseFace() {
+  if (face)
+    FT_Done_Face(face);
+  if (ft)
+    FT_Done_FreeType(ft);
+  face = nullptr;
+  ft = nullptr;
+}
+
+/**
+ * @brief Selects a font and preloads the printable ASCII glyphs
+ * @param font Path to the font file
+ * @param fontSize Size of the font to load
+ */
+void TextRenderer::Load(const std::string &font, unsigned int fontSize) {
+  CloseFace();
+  this->fontPath = font;
+  this->fontSize = fontSize;
+
+  // The cache key covers everything the distance fields depend on
+  fontKey = AssetCache::HashFileStamp(font);
+  unsigned int params[3] = {fontSize, SDF_UPSCALE, SDF_SPREAD};
+  fontKey = AssetCache::Hash(params, sizeof(params), fontKey);
+
+  // Forget every glyph of the previous font
+  for (int c = 0; c < GLYPH_COUNT; c++) {
+    Characters[c] = Character{glm::ivec2(0), glm::ivec2(0), 0, glm::vec2(0.0f),
+                              glm::vec2(0.0f), false, -1};
+  }
+  extendedGlyphs.clear();
+  shelves.clear();
+
+  // Equal-height shelves are enough for one font size: a field is at most
+  // the font's line height plus the spread on both sides
+  shelfHeight = static_cast<int>(fontSize) * 3 / 2 + 2 * SDF_SPREAD + 1;
+
+  // Allocate a cleared atlas; glyphs are added with glTexSubImage2D.
+  // Empty texels are fully "outside" so bilinear filtering at glyph edges
+  // does not pick up the neighbouring glyph.
+  std::vector<unsigned char> atlas(static_cast<size_t>(ATLAS_SIZE) *
+                                       ATLAS_SIZE,
+                                   0);
+  if (AtlasTexture == 0)
+    glGenTextures(1, &AtlasTexture);
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, AtlasTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RED,
+               GL_UNSIGNED_BYTE, atlas.data());
+
+  // Set texture options (linear filtering interpolates the distances)
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  // Cached layouts refer to the old metrics/atlas
+  generation++;
+
+  // Printable ASCII is needed by nearly every string, load it up front
+  for (uint32_t c = 32; c < 127; c++)
+    GetGlyph(c);
+
+  std::cout << "Font '" << font << "' loaded successfully! (SDF atlas "
+            << ATLAS_SIZE << "x" << ATLAS_SIZE << ", " << shelves.size()
+            << " shelves in use)" << std::endl;
+}
+
+/**
+ * @brief Gets the distance field of a glyph from the disk cache or FreeType
+ * @param codepoint Character to load
+ * @param glyph Resulting glyph
+ * @return false if the glyph could not be produced
+ */
+bool TextRenderer::LoadGlyphBitmap(uint32_t codepoint, GlyphBitmap &glyph) {
+  TRACE_SCOPE("TextRenderer::LoadGlyphBitmap");
+
+  std::string cachePath = AssetCache::PathFor(
+      "fonts", AssetCache::Hash(&codepoint, sizeof(codepoint), fontKey),
+      ".sdf");
+  if (ReadGlyphCache(cachePath, codepoint, glyph))
+    return true;
+
+  if (!OpenFace() || !RasterizeGlyph(face, codepoint, glyph)) {
+    std::cout << "ERROR::FREETYPE: Failed to load Glyph U+" << std::hex
+              << codepoint << std::dec << std::endl;
+    return false;
+  }
+  WriteGlyphCache(cachePath, codepoint, glyph);
+  return true;
+}
+
+/**
+ * @brief Copies a glyph's field into the atlas, evicting a shelf if needed
+ * @param codepoint Character being placed
+ * @param ch Glyph metrics (UVs and shelf are filled in)
+ * @param glyph Distance field to upload
+ * @return Index of the shelf used, -1 if the atlas is full for now, or
+ * UNPLACEABLE_SHELF if the glyph can never fit
+ */
+int TextRenderer::PlaceInAtlas(uint32_t codepoint, Character &ch,
+                               const GlyphBitmap &glyph) {
+  const int PADDING = 1;
+  int w = glyph.Size.x, h = glyph.Size.y;
+  if (h + PADDING > shelfHeight || w + 2 * PADDING > ATLAS_SIZE) {
+    std::cout << "WARNING: Glyph U+" << std::hex << codepoint << std::dec
+              << " is too large for the text atlas" << std::endl;
+    return UNPLACEABLE_SHELF;
+  }
 
-  // Load first 128 characters of ASCII set
-  for (unsigned char c = 0; c < 128; c++) {
-    // Load character glyph
-    if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-      std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
-      continue;
+  // First shelf with room, otherwise open a new one
+  int index = -1;
+  for (size_t i = 0; i < shelves.size() && index < 0; i++) {
+    if (shelves[i].PenX + w + PADDING <= ATLAS_SIZE)
+      index = static_cast<int>(i);
+  }
+  int shelfCount = ATLAS_SIZE / shelfHeight;
+  if (index < 0 && static_cast<int>(shelves.size()) < shelfCount) {
+    shelves.push_back(Shelf{PADDING, 0, {}});
+    index = static_cast<int>(shelves.size()) - 1;
+  }
+
+  // Atlas full: evict the least recently used shelf that the current
+  // batch does not reference
+  if (index < 0) {
+    for (size_t i = 0; i < shelves.size(); i++) {
+      if (shelves[i].LastUsed == batchStamp)
+        continue;
+      if (index < 0 || shelves[i].LastUsed < shelves[index].LastUsed)
+        index = static_cast<int>(i);
+    }
+    if (index < 0) {
+      std::cout << "WARNING: Text atlas is full, glyph U+" << std::hex
+                << codepoint << std::dec << " skipped" << std::endl;
+      return -1;
     }
 
-    // Generate texture
-    unsigned int texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, face->glyph->bitmap.width,
-                 face->glyph->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE,
-                 face->glyph->bitmap.buffer);
+    Shelf &victim = shelves[index];
+    for (uint32_t evicted : victim.Glyphs) {
+      Character &old = evicted < GLYPH_COUNT ? Characters[evicted]
+                                             : extendedGlyphs[evicted];
+      old.Shelf = -1;
+    }
+    victim = Shelf{PADDING, 0, {}};
 
-    // Set texture options
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Clear the shelf so leftovers do not bleed into new glyphs
+    std::vector<unsigned char> zeros(
+        static_cast<size_t>(ATLAS_SIZE) * shelfHeight, 0);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, AtlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, index * shelfHeight, ATLAS_SIZE,
+                    shelfHeight, GL_RED, GL_UNSIGNED_BYTE, zeros.data());
 
-    // Store character for later use
-    Character character = {
-        texture,
-        glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-        glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-        static_cast<unsigned int>(face->glyph->advance.x)};
-    Characters.insert(std::pair<char, Character>(c, character));
+    // UVs of the evicted glyphs are stale in any cached geometry
+    generation++;
   }
-  glBindTexture(GL_TEXTURE_2D, 0);
 
-  // Destroy FreeType once we're finished
-  FT_Done_Face(face);
-  FT_Done_FreeType(ft);
+  Shelf &shelf = shelves[index];
+  int x = shelf.PenX;
+  int y = index * shelfHeight + PADDING;
+  shelf.PenX += w + PADDING;
+  shelf.Glyphs.push_back(codepoint);
 
-  std::cout << "Font '" << font << "' loaded successfully!" << std::endl;
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, AtlasTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE,
+                  glyph.Pixels.data());
+
+  ch.UVMin = glm::vec2(static_cast<float>(x) / ATLAS_SIZE,
+                       static_cast<float>(y) / ATLAS_SIZE);
+  ch.UVMax = glm::vec2(static_cast<float>(x + w) / ATLAS_SIZE,
+                       static_cast<float>(y + h) / ATLAS_SIZE);
+  return index;
 }
 
 /**
- * @brief Renders a string of text using the precompiled list of characters
+ * @brief Looks up a glyph, loading it into the atlas on first use
+ *
+ * Marks the glyph's shelf as used by the current batch.
+ *
+ * @param codepoint Unicode codepoint
+ * @return Glyph metrics (empty if the glyph could not be loaded)
+ */
+Character &TextRenderer::GetGlyph(uint32_t codepoint) {
+  Character *ch;
+  if (codepoint < GLYPH_COUNT) {
+    ch = &Characters[codepoint];
+  } else {
+    auto it = extendedGlyphs.find(codepoint);
+    if (it == extendedGlyphs.end()) {
+      it = extendedGlyphs
+               .emplace(codepoint,
+                        Character{glm::ivec2(0), glm::ivec2(0), 0,
+                                  glm::vec2(0.0f), glm::vec2(0.0f), false, -1})
+               .first;
+    }
+    ch = &it->second;
+  }
+
+  // Whitespace and failed glyphs have metrics but nothing in the atlas;
+  // evicted glyphs and those that met a full atlas are loaded again
+  bool needsAtlas = !ch->Loaded || (ch->Shelf == -1 && ch->Size.x > 0 &&
+                                    ch->Size.y > 0);
+  if (needsAtlas && fontSize > 0) {
+    GlyphBitmap glyph;
+    ch->Loaded = true;
+    if (LoadGlyphBitmap(codepoint, glyph)) {
+      ch->Size = glyph.Size;
+      ch->Bearing = glyph.Bearing;
+      ch->Advance = glyph.Advance;
+      if (glyph.Size.x > 0 && glyph.Size.y > 0)
+        ch->Shelf = PlaceInAtlas(codepoint, *ch, glyph);
+    }
+  }
+
+  if (ch->Shelf >= 0)
+    shelves[ch->Shelf].LastUsed = batchStamp;
+  return *ch;
+}
+
+/**
+ * @brief Renders a string of text (and anything queued before) in one draw
+ * @param text The text string to render
+ * @param x Screen X position
+ * @param y Screen Y position
+ * @param scale Scaling factor
+ * @param color Text color (RGB)
+ */
+void TextRenderer::RenderText(const std::string &text, float x, float y,
+                              float scale, glm::vec3 color) {
+  QueueText(text, x, y, scale, color);
+  Flush();
+}
+
+/**
+ * @brief Appends the quads of a string to the pending batch
  * @param text The text string to render
  * @param x Screen X position
  * @param y Screen Y position
  * @param scale Scaling factor
  * @param color Text color (RGB)
  */
-void TextRenderer::RenderText(std::string text, float x, float y, float scale,
-                              glm::vec3 color) {
-  // Activate corresponding render state
-  glUseProgram(this->TextShader);
-  glUniform3f(glGetUniformLocation(this->TextShader, "textColor"), color.x,
-              color.y, color.z);
-  glActiveTexture(GL_TEXTURE0);
-  glBindVertexArray(this->VAO);
+void TextRenderer::QueueText(const std::string &text, float x, float y,
+                             float scale, glm::vec3 color) {
+  AppendQuads(batch, text, x, y, scale, color);
+}
+
+/**
+ * @brief Shapes a string into quads appended to a vertex array
+ * @param out Destination vertex array
+ * @param text The text string to shape
+ * @param x Screen X position
+ * @param y Screen Y position
+ * @param scale Scaling factor
+ * @param color Text color (RGB)
+ */
+void TextRenderer::AppendQuads(std::vector<float> &out, const std::string &text,
+                               float x, float y, float scale,
+                               glm::vec3 color) {
+  out.reserve(out.size() + text.size() * 6 * FLOATS_PER_VERTEX);
 
   // Iterate through all characters
-  std::string::const_iterator c;
-  for (c = text.begin(); c != text.end(); c++) {
-    Character ch = Characters[*c];
-
-    float xpos = x + ch.Bearing.x * scale;
-    float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-    float w = ch.Size.x * scale;
-    float h = ch.Size.y * scale;
-
-    // Update VBO for each character
-    float vertices[6][4] = {
-        {xpos, ypos + h, 0.0f, 0.0f},    {xpos, ypos, 0.0f, 1.0f},
-        {xpos + w, ypos, 1.0f, 1.0f},
-
-        {xpos, ypos + h, 0.0f, 0.0f},    {xpos + w, ypos, 1.0f, 1.0f},
-        {xpos + w, ypos + h, 1.0f, 0.0f}};
-
-    // Render glyph texture over quad
-    glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-    // Update content of VBO memory
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    // Render quad
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+  for (size_t i = 0; i < text.size();) {
+    const Character &ch = GetGlyph(DecodeUtf8(text, i));
+
+    // Whitespace (and glyphs that did not fit) has no quad, only an advance
+    if (ch.Shelf >= 0) {
+      float xpos = x + ch.Bearing.x * scale;
+      float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+      float w = ch.Size.x * scale;
+      float h = ch.Size.y * scale;
+
+      float u0 = ch.UVMin.x, v0 = ch.UVMin.y;
+      float u1 = ch.UVMax.x, v1 = ch.UVMax.y;
+
+      float vertices[6][FLOATS_PER_VERTEX] = {
+          {xpos, ypos + h, u0, v0, color.x, color.y, color.z},
+          {xpos, ypos, u0, v1, color.x, color.y, color.z},
+          {xpos + w, ypos, u1, v1, color.x, color.y, color.z},
+
+          {xpos, ypos + h, u0, v0, color.x, color.y, color.z},
+          {xpos + w, ypos, u1, v1, color.x, color.y, color.z},
+          {xpos + w, ypos + h, u1, v0, color.x, color.y, color.z}};
+      out.insert(out.end(), &vertices[0][0],
+                 &vertices[0][0] + 6 * FLOATS_PER_VERTEX);
+    }
+
     // Advance cursors for next glyph
     x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels
   }
-  glBindVertexArray(0);
-  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief Sets the text vertex format on the bound VAO/VBO
+ */
+void TextRenderer::ConfigureVertexAttributes() {
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE,
+                        FLOATS_PER_VERTEX * sizeof(float), (void *)0);
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
+                        FLOATS_PER_VERTEX * sizeof(float),
+                        (void *)(4 * sizeof(float)));
+}
+
+/**
+ * @brief Draws pre-built text vertices with the text shader and atlas
+ * @param vao VAO holding the vertices
+ * @param vertexCount Number of vertices
+ */
+void TextRenderer::DrawVertices(unsigned int vao, int vertexCount) {
+  if (vertexCount <= 0)
+    return;
+
+  // Consecutive text draws share the program and atlas; only the VAO
+  // changes between layouts
+  GLStateCache &state = GLStateCache::Get();
+  state.UseProgram(this->TextShader);
+  state.BindTexture(0, GL_TEXTURE_2D, this->AtlasTexture);
+  state.BindVertexArray(vao);
+  glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+  RenderStats::RecordDraw(vertexCount);
+
+  // The batch is on its way to the GPU, its shelves may be evicted again
+  batchStamp++;
+}
+
+/**
+ * @brief Uploads the pending batch and draws it with a single call
+ */
+void TextRenderer::Flush() {
+  if (batch.empty())
+    return;
+
+  size_t bytes = batch.size() * sizeof(float);
+
+  // Grow the buffer if needed, otherwise refill it
+  GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, this->VBO);
+  if (bytes > bufferCapacity) {
+    bufferCapacity = std::max(bytes, bufferCapacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, bufferCapacity, NULL, GL_STREAM_DRAW);
+  }
+  glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, batch.data());
+
+  DrawVertices(this->VAO,
+               static_cast<int>(batch.size() / FLOATS_PER_VERTEX));
+  batch.clear();
 }
 
 /**
@@ -202,12 +654,10 @@ void TextRenderer::RenderText(std::string text, float x, float y, float scale,
  * @param scale The scale factor to apply
  * @return Total width in pixels
  */
-float TextRenderer::CalculateTextWidth(std::string text, float scale) {
+float TextRenderer::CalculateTextWidth(const std::string &text,
+                                       float scale) {
   float width = 0.0f;
-  std::string::const_iterator c;
-  for (c = text.begin(); c != text.end(); c++) {
-    Character ch = Characters[*c];
-    width += (ch.Advance >> 6) * scale;
-  }
+  for (size_t i = 0; i < text.size();)
+    width += (GetGlyph(DecodeUtf8(text, i)).Advance >> 6) * scale;
   return width;
 }
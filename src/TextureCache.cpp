@@ -0,0 +1,302 @@
+/**
+ * @file TextureCache.cpp
+ * @brief Implementation of the TextureCache class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/TextureCache.h"
+#include "../include/AssetCache.h"
+#include "../include/Trace.h"
+#include "../include/stb_image.h"
+#include "glad/glad.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+/// Identifies cooked texture files ("MZTX")
+const uint32_t TEXTURE_CACHE_MAGIC = 0x58545a4d;
+/// Bump when the file layout or the cooking changes
+const uint32_t TEXTURE_CACHE_VERSION = 1;
+/// More levels than any 32-bit texture size can have
+const uint32_t MAX_LEVELS = 32;
+
+/// Level table entry as stored in the file
+struct LevelRecord {
+  uint32_t width, height;
+  uint64_t offset, size;
+};
+
+/**
+ * @brief True if every texel is grey (and opaque, with an alpha channel)
+ */
+bool IsGrey(const unsigned char *pixels, size_t count, int channels) {
+  for (size_t i = 0; i < count; i++) {
+    const unsigned char *texel = pixels + i * channels;
+    if (texel[0] != texel[1] || texel[0] != texel[2])
+      return false;
+    if (channels == 4 && texel[3] != 255)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Halves a level with a 2x2 box filter (edges clamp on odd sizes)
+ */
+void Downsample(const unsigned char *source, int sourceWidth,
+                int sourceHeight, unsigned char *target, int width,
+                int height, int channels) {
+  for (int y = 0; y < height; y++) {
+    const unsigned char *row0 =
+        source + static_cast<size_t>(std::min(2 * y, sourceHeight - 1)) *
+                     sourceWidth * channels;
+    const unsigned char *row1 =
+        source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) *
+                     sourceWidth * channels;
+    for (int x = 0; x < width; x++) {
+      int x0 = std::min(2 * x, sourceWidth - 1) * channels;
+      int x1 = std::min(2 * x + 1, sourceWidth - 1) * channels;
+      for (int c = 0; c < channels; c++) {
+        int sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+        *target++ = static_cast<unsigned char>((sum + 2) >> 2);
+      }
+    }
+  }
+}
+
+} // namespace
+
+CookedTexture::CookedTexture()
+    : Width(0), Height(0), Channels(0), Data(nullptr), Size(0) {}
+
+CookedTexture::~CookedTexture() { Release(); }
+
+CookedTexture::CookedTexture(CookedTexture &&other) noexcept
+    : CookedTexture() {
+  *this = std::move(other);
+}
+
+CookedTexture &CookedTexture::operator=(CookedTexture &&other) noexcept {
+  if (this != &other) {
+    Release();
+    Width = other.Width;
+    Height = other.Height;
+    Channels = other.Channels;
+    Levels = std::move(other.Levels);
+    Data = other.Data;
+    Size = other.Size;
+    // Both keep their buffers on move, so Data stays valid
+    storage = std::move(other.storage);
+    file = std::move(other.file);
+    other.Release();
+  }
+  return *this;
+}
+
+void CookedTexture::Release() {
+  file.Close();
+  storage.clear();
+  storage.shrink_to_fit();
+  Levels.clear();
+  Data = nullptr;
+  Size = 0;
+  Width = Height = Channels = 0;
+}
+
+unsigned int CookedTexture::InternalFormat() const {
+  switch (Channels) {
+  case 1:
+    return GL_R8;
+  case 2:
+    return GL_RG8;
+  case 3:
+    return GL_RGB8;
+  default:
+    return GL_RGBA8;
+  }
+}
+
+unsigned int CookedTexture::Format() const {
+  switch (Channels) {
+  case 1:
+    return GL_RED;
+  case 2:
+    return GL_RG;
+  case 3:
+    return GL_RGB;
+  default:
+    return GL_RGBA;
+  }
+}
+
+/**
+ * @brief Maps the cooked file, cooking (and storing) it on a miss
+ */
+bool TextureCache::Load(const std::string &path, CookedTexture &texture) {
+  TRACE_SCOPE("TextureCache::Load");
+  std::string cachePath = AssetCache::PathFor(
+      "textures", AssetCache::HashFileStamp(path), ".tex");
+  if (MapCooked(cachePath, texture))
+    return true;
+
+  if (!Cook(path, texture))
+    return false;
+  WriteCooked(cachePath, texture);
+
+  // Textures are kept for mip streaming: trade the heap copy for a mapping
+  CookedTexture mapped;
+  if (MapCooked(cachePath, mapped))
+    texture = std::move(mapped);
+  return true;
+}
+
+/**
+ * @brief Maps a cooked file and checks its layout
+ * @param cachePath Cache file
+ * @param texture Filled on success
+ * @return false if the file is missing, outdated or truncated
+ */
+bool TextureCache::MapCooked(const std::string &cachePath,
+                             CookedTexture &texture) {
+  texture.Release();
+  if (!texture.file.Open(cachePath))
+    return false;
+  const unsigned char *base = texture.file.Data();
+  size_t fileSize = texture.file.Size();
+
+  uint32_t header[6]; // magic, version, width, height, channels, levels
+  if (fileSize < sizeof(header)) {
+    texture.Release();
+    return false;
+  }
+  std::memcpy(header, base, sizeof(header));
+  uint32_t levelCount = header[5];
+  size_t dataStart = sizeof(header) + levelCount * sizeof(LevelRecord);
+  if (header[0] != TEXTURE_CACHE_MAGIC ||
+      header[1] != TEXTURE_CACHE_VERSION || header[4] < 1 || header[4] > 4 ||
+      levelCount < 1 || levelCount > MAX_LEVELS || dataStart > fileSize) {
+    texture.Release();
+    return false;
+  }
+
+  texture.Width = static_cast<int>(header[2]);
+  texture.Height = static_cast<int>(header[3]);
+  texture.Channels = static_cast<int>(header[4]);
+  texture.Data = base + dataStart;
+  texture.Size = fileSize - dataStart;
+  for (uint32_t i = 0; i < levelCount; i++) {
+    LevelRecord record;
+    std::memcpy(&record, base + sizeof(header) + i * sizeof(LevelRecord),
+                sizeof(record));
+    uint64_t expected =
+        static_cast<uint64_t>(record.width) * record.height * texture.Channels;
+    if (record.size != expected || record.offset > texture.Size ||
+        record.size > texture.Size - record.offset) {
+      texture.Release();
+      return false;
+    }
+    texture.Levels.push_back(
+        CookedTexture::Level{static_cast<int>(record.width),
+                             static_cast<int>(record.height),
+                             static_cast<size_t>(record.offset),
+                             static_cast<size_t>(record.size)});
+  }
+  return true;
+}
+
+/**
+ * @brief Decodes an image and builds its mip chain
+ * @param path Source image file
+ * @param texture Filled on success
+ * @return false if the image could not be decoded
+ */
+bool TextureCache::Cook(const std::string &path, CookedTexture &texture) {
+  TRACE_SCOPE("TextureCache::Cook");
+  texture.Release();
+
+  // Per-thread flag: other threads' stb_image settings are left alone
+  stbi_set_flip_vertically_on_load_thread(true);
+  int width, height, channels;
+  unsigned char *pixels =
+      stbi_load(path.c_str(), &width, &height, &channels, 0);
+  if (!pixels)
+    return false;
+
+  // Grey images (roughness maps) are stored as R8 instead of RGB
+  size_t texels = static_cast<size_t>(width) * height;
+  int cooked =
+      channels >= 3 && IsGrey(pixels, texels, channels) ? 1 : channels;
+
+  // Full chain down to 1x1
+  size_t total = 0;
+  for (int w = width, h = height;; w = std::max(1, w / 2),
+           h = std::max(1, h / 2)) {
+    size_t size = static_cast<size_t>(w) * h * cooked;
+    texture.Levels.push_back(CookedTexture::Level{w, h, total, size});
+    total += size;
+    if (w == 1 && h == 1)
+      break;
+  }
+
+  texture.storage.resize(total);
+  unsigned char *data = texture.storage.data();
+  if (cooked == channels) {
+    std::memcpy(data, pixels, texels * channels);
+  } else {
+    for (size_t i = 0; i < texels; i++)
+      data[i] = pixels[i * channels];
+  }
+  stbi_image_free(pixels);
+
+  for (size_t i = 1; i < texture.Levels.size(); i++) {
+    const CookedTexture::Level &source = texture.Levels[i - 1];
+    const CookedTexture::Level &level = texture.Levels[i];
+    Downsample(data + source.Offset, source.Width, source.Height,
+               data + level.Offset, level.Width, level.Height, cooked);
+  }
+
+  texture.Width = width;
+  texture.Height = height;
+  texture.Channels = cooked;
+  texture.Data = data;
+  texture.Size = total;
+  std::cout << "Cooked texture: " << path << " (" << width << "x" << height
+            << ", " << cooked << " channel(s), " << texture.Levels.size()
+            << " levels)" << std::endl;
+  return true;
+}
+
+/**
+ * @brief Stores a cooked texture for the next launch
+ * @param cachePath Cache file
+ * @param texture Freshly cooked texture
+ */
+void TextureCache::WriteCooked(const std::string &cachePath,
+                               const CookedTexture &texture) {
+  // Other processes may be streaming levels from a mapping of this file
+  bool written = AssetCache::WriteAtomic(cachePath, [&](std::ostream &file) {
+    uint32_t header[6] = {TEXTURE_CACHE_MAGIC,
+                          TEXTURE_CACHE_VERSION,
+                          static_cast<uint32_t>(texture.Width),
+                          static_cast<uint32_t>(texture.Height),
+                          static_cast<uint32_t>(texture.Channels),
+                          static_cast<uint32_t>(texture.Levels.size())};
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    for (const CookedTexture::Level &level : texture.Levels) {
+      LevelRecord record = {static_cast<uint32_t>(level.Width),
+                            static_cast<uint32_t>(level.Height), level.Offset,
+                            level.Size};
+      file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+    file.write(reinterpret_cast<const char *>(texture.Data), texture.Size);
+  });
+  if (!written) {
+    std::cout << "WARNING: Could not write texture cache: " << cachePath
+              << std::endl;
+  }
+}
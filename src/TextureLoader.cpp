@@ -0,0 +1,92 @@
+/**
+ * @file TextureLoader.cpp
+ * @brief Implementation of the TextureLoader class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/TextureLoader.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <utility>
+
+TextureLoader::TextureLoader() : loading(0), stopping(false) {
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+  int count = std::max(1, std::min(MAX_WORKERS, cores - 1));
+  for (int i = 0; i < count; i++)
+    workers.emplace_back(&TextureLoader::WorkerLoop, this);
+}
+
+TextureLoader::~TextureLoader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  jobQueued.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+  // Cooked images release their pixels with the jobs
+}
+
+void TextureLoader::Queue(unsigned int texture, const std::string &path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queued.push_back(Job{texture, path, CookedTexture()});
+  }
+  jobQueued.notify_one();
+}
+
+/**
+ * @brief Fetches cooked textures for queued files until destroyed
+ */
+void TextureLoader::WorkerLoop() {
+  TRACE_THREAD_NAME("texture worker");
+
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobQueued.wait(lock, [this] { return stopping || !queued.empty(); });
+      if (stopping)
+        return;
+      job = std::move(queued.front());
+      queued.pop_front();
+      loading++;
+    }
+
+    // Leaves the image empty if the file cannot be decoded
+    TextureCache::Load(job.path, job.image);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.push_back(std::move(job));
+      loading--;
+    }
+    jobFinished.notify_all();
+  }
+}
+
+bool TextureLoader::Poll(unsigned int &texture, std::string &path,
+                         CookedTexture &image) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (finished.empty())
+    return false;
+  Job &job = finished.front();
+  texture = job.texture;
+  path = std::move(job.path);
+  image = std::move(job.image);
+  finished.pop_front();
+  return true;
+}
+
+void TextureLoader::Wait() {
+  TRACE_SCOPE("TextureLoader::Wait");
+  std::unique_lock<std::mutex> lock(mutex);
+  jobFinished.wait(lock,
+                   [this] { return queued.empty() && loading == 0; });
+}
+
+int TextureLoader::Pending() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return static_cast<int>(queued.size()) + loading;
+}
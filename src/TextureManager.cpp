@@ -0,0 +1,347 @@
+/**
+ * @file TextureManager.cpp
+ * @brief Implementation of the TextureManager class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/TextureManager.h"
+#include "../include/GLStateCache.h"
+#include "../include/Trace.h"
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+/// Estimated GPU bytes of one level (RGB is padded to 4 bytes per texel)
+size_t LevelBytes(const CookedTexture &image, int level) {
+  const CookedTexture::Level &info = image.Levels[level];
+  int bytesPerTexel = image.Channels == 3 ? 4 : image.Channels;
+  return static_cast<size_t>(info.Width) * info.Height * bytesPerTexel;
+}
+
+/// Estimated GPU bytes of the levels from `first` down to 1x1
+size_t ChainBytes(const CookedTexture &image, int first) {
+  size_t total = 0;
+  for (size_t level = first; level < image.Levels.size(); level++)
+    total += LevelBytes(image, static_cast<int>(level));
+  return total;
+}
+
+/// Largest level index a texture may be reduced to
+int LowestTarget(const CookedTexture &image) {
+  int levels = static_cast<int>(image.Levels.size());
+  for (int level = 0; level < levels; level++) {
+    const CookedTexture::Level &info = image.Levels[level];
+    if (std::max(info.Width, info.Height) <= TextureManager::MIN_RESIDENT_SIZE)
+      return level;
+  }
+  return levels - 1;
+}
+
+} // namespace
+
+TextureManager::TextureManager(size_t memoryBudget)
+    : memoryBudget(memoryBudget), residentBytes(0), pixelBuffer(0),
+      stagingTexture(0), stagingLevel(0), stagedBytes(0) {
+  std::cout << "Texture memory budget: ";
+  if (memoryBudget > 0)
+    std::cout << (memoryBudget >> 20) << " MB" << std::endl;
+  else
+    std::cout << "unlimited" << std::endl;
+}
+
+TextureManager::~TextureManager() {
+  if (pixelBuffer != 0)
+    GLStateCache::Get().DeleteBuffers(1, &pixelBuffer);
+}
+
+/**
+ * @brief Creates the placeholder texture and queues the file
+ */
+unsigned int TextureManager::Load(const std::string &path, unsigned char r,
+                                  unsigned char g, unsigned char b) {
+  unsigned int texture;
+  glGenTextures(1, &texture);
+
+  const unsigned char texel[4] = {r, g, b, 255};
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               texel);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  // No mipmaps yet: a mipmapped filter would make the placeholder incomplete
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  entries.emplace(texture, Entry{path, CookedTexture(), 0, 0, 0.0f, 1.0f,
+                                 false, false});
+  loader.Queue(texture, path);
+  return texture;
+}
+
+void TextureManager::Request(unsigned int texture, float distance,
+                             float importance) {
+  auto it = entries.find(texture);
+  if (it == entries.end())
+    return;
+  Entry &entry = it->second;
+  if (!entry.requested || distance < entry.distance)
+    entry.distance = std::max(0.0f, distance);
+  entry.importance = importance;
+  entry.requested = true;
+}
+
+/**
+ * @brief One frame of residency work: budget first, then streaming
+ */
+void TextureManager::Update(size_t byteBudget) {
+  TRACE_SCOPE("TextureManager::Update");
+  ReceiveLoaded();
+  ComputeTargets();
+  DropLevels();
+
+  GLStateCache &state = GLStateCache::Get();
+  bool boundBuffer = false;
+  while (byteBudget > 0) {
+    // Give up a half-staged level its texture no longer wants
+    if (stagingTexture != 0) {
+      const Entry &entry = entries.at(stagingTexture);
+      if (stagingLevel != entry.baseLevel - 1 ||
+          stagingLevel < entry.targetLevel)
+        stagingTexture = 0;
+    }
+    if (stagingTexture == 0) {
+      if (!NextLevel(stagingTexture, stagingLevel))
+        break;
+      stagedBytes = 0;
+    }
+
+    if (pixelBuffer == 0)
+      glGenBuffers(1, &pixelBuffer);
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    boundBuffer = true;
+
+    Entry &entry = entries.at(stagingTexture);
+    if (StageLevel(entry, byteBudget)) {
+      UploadLevel(entry);
+      stagingTexture = 0;
+    }
+  }
+
+  // Later glTexImage2D calls must read from client memory again
+  if (boundBuffer)
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureManager::ReceiveLoaded() {
+  unsigned int texture;
+  std::string path;
+  CookedTexture image;
+  while (loader.Poll(texture, path, image)) {
+    auto it = entries.find(texture);
+    if (it == entries.end())
+      continue;
+    if (!image.Valid()) {
+      // Keep the placeholder; the game still runs without the image
+      std::cout << "Texture failed to load at path: " << path << std::endl;
+      entries.erase(it);
+      continue;
+    }
+
+    std::cout << "Texture Loaded! Path: " << path << " | W: " << image.Width
+              << " H: " << image.Height << " Ch: " << image.Channels
+              << " Levels: " << image.Levels.size() << std::endl;
+    Entry &entry = it->second;
+    entry.image = std::move(image);
+    entry.baseLevel = entry.targetLevel =
+        static_cast<int>(entry.image.Levels.size());
+    entry.loaded = true;
+  }
+}
+
+/**
+ * @brief Wanted levels from the distances, then cuts until within budget
+ */
+void TextureManager::ComputeTargets() {
+  size_t total = 0;
+  for (auto &pair : entries) {
+    Entry &entry = pair.second;
+    entry.requested = false; // Distances of the next frame start over
+    if (!entry.loaded)
+      continue;
+
+    int wanted = 0;
+    if (entry.distance > FULL_DETAIL_DISTANCE) {
+      wanted = static_cast<int>(
+          std::floor(std::log2(entry.distance / FULL_DETAIL_DISTANCE)));
+    }
+    entry.targetLevel = std::min(wanted, LowestTarget(entry.image));
+    total += ChainBytes(entry.image, entry.targetLevel);
+  }
+  if (memoryBudget == 0)
+    return;
+
+  // Each cut drops the top level that buys the least: the largest level,
+  // weighted by distance and divided by importance
+  while (total > memoryBudget) {
+    Entry *victim = nullptr;
+    float worst = 0.0f;
+    for (auto &pair : entries) {
+      Entry &entry = pair.second;
+      if (!entry.loaded || entry.targetLevel >= LowestTarget(entry.image))
+        continue;
+      float cost =
+          static_cast<float>(LevelBytes(entry.image, entry.targetLevel)) *
+          (1.0f + entry.distance) / std::max(entry.importance, 0.01f);
+      if (!victim || cost > worst) {
+        victim = &entry;
+        worst = cost;
+      }
+    }
+    if (!victim)
+      break; // Every texture is at its smallest allowed size
+
+    total -= LevelBytes(victim->image, victim->targetLevel);
+    victim->targetLevel++;
+  }
+}
+
+/**
+ * @brief Frees resident levels above the targets
+ */
+void TextureManager::DropLevels() {
+  GLStateCache &state = GLStateCache::Get();
+  for (auto &pair : entries) {
+    Entry &entry = pair.second;
+    if (!entry.loaded || entry.baseLevel >= entry.targetLevel)
+      continue;
+
+    const CookedTexture &image = entry.image;
+    state.BindTexture(0, GL_TEXTURE_2D, pair.first);
+    // Sampling moves down first, then the larger levels are released
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, entry.targetLevel);
+    for (int level = entry.baseLevel; level < entry.targetLevel; level++) {
+      glTexImage2D(GL_TEXTURE_2D, level, image.InternalFormat(), 0, 0, 0,
+                   image.Format(), GL_UNSIGNED_BYTE, nullptr);
+      residentBytes -= LevelBytes(image, level);
+    }
+    entry.baseLevel = entry.targetLevel;
+  }
+}
+
+/**
+ * @brief The smallest missing level of any texture goes first
+ *
+ * Every texture gets its low-resolution levels before any texture gets a
+ * large one, so the scene looks complete quickly and then sharpens.
+ */
+bool TextureManager::NextLevel(unsigned int &texture, int &level) {
+  const Entry *best = nullptr;
+  size_t bestBytes = 0;
+  float bestPriority = 0.0f;
+  for (const auto &pair : entries) {
+    const Entry &entry = pair.second;
+    if (!entry.loaded || entry.baseLevel <= entry.targetLevel)
+      continue;
+
+    size_t bytes = LevelBytes(entry.image, entry.baseLevel - 1);
+    float priority = entry.importance / (1.0f + entry.distance);
+    if (!best || bytes < bestBytes ||
+        (bytes == bestBytes && priority > bestPriority)) {
+      best = &entry;
+      texture = pair.first;
+      bestBytes = bytes;
+      bestPriority = priority;
+    }
+  }
+  if (!best)
+    return false;
+  level = best->baseLevel - 1;
+  return true;
+}
+
+/**
+ * @brief Copies the next part of the staging level into the bound PBO
+ */
+bool TextureManager::StageLevel(const Entry &entry, size_t &byteBudget) {
+  const CookedTexture::Level &level = entry.image.Levels[stagingLevel];
+  if (stagedBytes == 0) {
+    // Orphan the previous level's storage instead of waiting for it
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, level.Size, nullptr, GL_STREAM_DRAW);
+  }
+
+  size_t chunk = std::min(byteBudget, level.Size - stagedBytes);
+  const unsigned char *source = entry.image.Data + level.Offset + stagedBytes;
+  // Fresh storage, so the written range cannot be in use by the GPU
+  void *target = glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, stagedBytes, chunk,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+          GL_MAP_UNSYNCHRONIZED_BIT);
+  if (target) {
+    std::memcpy(target, source, chunk);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  } else {
+    glBufferSubData(GL_PIXEL_UNPACK_BUFFER, stagedBytes, chunk, source);
+  }
+  stagedBytes += chunk;
+  byteBudget -= chunk;
+  return stagedBytes >= level.Size;
+}
+
+/**
+ * @brief Defines the staged level and makes it the top of the chain
+ */
+void TextureManager::UploadLevel(Entry &entry) {
+  TRACE_SCOPE("TextureManager::UploadLevel");
+  const CookedTexture &image = entry.image;
+  const CookedTexture::Level &level = image.Levels[stagingLevel];
+
+  GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, stagingTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  // Reads from the bound PBO (offset 0); the copy runs asynchronously
+  glTexImage2D(GL_TEXTURE_2D, stagingLevel, image.InternalFormat(),
+               level.Width, level.Height, 0, image.Format(), GL_UNSIGNED_BYTE,
+               nullptr);
+
+  if (entry.baseLevel == static_cast<int>(image.Levels.size())) {
+    // First real level: the placeholder (level 0) falls outside the range
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                    static_cast<GLint>(image.Levels.size()) - 1);
+    if (image.Channels == 1) {
+      // R8 storage, sampled as grey like the original RGB image
+      const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+      glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    GL_LINEAR_MIPMAP_LINEAR); // Trilinear filtering
+  }
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, stagingLevel);
+
+  entry.baseLevel = stagingLevel;
+  residentBytes += LevelBytes(image, stagingLevel);
+}
+
+/**
+ * @brief Blocks until every queued file is loaded, then streams it all in
+ */
+void TextureManager::Finish() {
+  TRACE_SCOPE("TextureManager::Finish");
+  loader.Wait();
+  Update(static_cast<size_t>(-1));
+}
+
+int TextureManager::Pending() {
+  int pending = 0;
+  for (const auto &pair : entries) {
+    const Entry &entry = pair.second;
+    if (!entry.loaded || entry.baseLevel > entry.targetLevel)
+      pending++;
+  }
+  return pending;
+}
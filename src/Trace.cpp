@@ -0,0 +1,162 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the Trace class
+ * @author Project CG - Maze Game
+ * @date 2025
+ */
+
+#include "../include/Trace.h"
+
+#ifdef MAZE_ENABLE_TRACING
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// One finished scope
+struct TraceEvent {
+  const char *name;
+  uint64_t start;
+  uint64_t end;
+};
+
+/**
+ * @brief Events of one thread
+ *
+ * Only the owning thread writes; `written` is published with release order
+ * so Flush sees complete events.
+ */
+struct ThreadRing {
+  std::unique_ptr<TraceEvent[]> events;
+  std::atomic<uint64_t> written{0};
+  unsigned int threadId = 0;
+  const char *threadName = nullptr;
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadRing>> rings;
+thread_local ThreadRing *localRing = nullptr;
+
+/**
+ * @brief Ring of the calling thread, registered on first use
+ */
+ThreadRing &LocalRing() {
+  if (!localRing) {
+    std::unique_ptr<ThreadRing> ring(new ThreadRing());
+    ring->events.reset(new TraceEvent[Trace::RING_CAPACITY]);
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    ring->threadId = static_cast<unsigned int>(rings.size()) + 1;
+    localRing = ring.get();
+    rings.push_back(std::move(ring)); // Outlives the thread until exit
+  }
+  return *localRing;
+}
+
+/**
+ * @brief Writes a string as a JSON literal
+ */
+void WriteJsonString(FILE *file, const char *text) {
+  fputc('"', file);
+  for (const char *c = text; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      fputc('\\', file);
+    fputc(*c, file);
+  }
+  fputc('"', file);
+}
+
+} // namespace
+
+/**
+ * @brief Nanoseconds since the first call (monotonic clock)
+ */
+uint64_t Trace::Now() {
+  using namespace std::chrono;
+  static const steady_clock::time_point epoch = steady_clock::now();
+  return static_cast<uint64_t>(
+      duration_cast<nanoseconds>(steady_clock::now() - epoch).count());
+}
+
+/**
+ * @brief Appends an event to the calling thread's ring
+ */
+void Trace::Record(const char *name, uint64_t start, uint64_t end) {
+  ThreadRing &ring = LocalRing();
+  uint64_t index = ring.written.load(std::memory_order_relaxed);
+  ring.events[index % RING_CAPACITY] = {name, start, end};
+  ring.written.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Names the calling thread
+ */
+void Trace::SetThreadName(const char *name) { LocalRing().threadName = name; }
+
+/**
+ * @brief Writes all rings as "complete" (ph X) events, in microseconds
+ */
+bool Trace::Flush(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file) {
+    std::cerr << "ERROR: Could not write trace file " << path << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  size_t total = 0;
+  bool first = true;
+  fputs("{\"traceEvents\":[\n", file);
+  for (const std::unique_ptr<ThreadRing> &ring : rings) {
+    if (ring->threadName) {
+      fprintf(file,
+              "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+              "\"tid\":%u,\"args\":{\"name\":",
+              first ? "" : ",\n", ring->threadId);
+      WriteJsonString(file, ring->threadName);
+      fputs("}}", file);
+      first = false;
+    }
+
+    uint64_t written = ring->written.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>(written, RING_CAPACITY);
+    for (uint64_t i = written - count; i < written; i++) {
+      const TraceEvent &event = ring->events[i % RING_CAPACITY];
+      fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+      WriteJsonString(file, event.name);
+      fprintf(file,
+              ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+              ring->threadId, event.start / 1000.0,
+              (event.end - event.start) / 1000.0);
+      first = false;
+    }
+    total += count;
+  }
+  fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+  bool ok = !ferror(file);
+  fclose(file);
+  if (ok)
+    std::cout << "Trace: wrote " << total << " events to " << path
+              << std::endl;
+  return ok;
+}
+
+#else // Tracing compiled out
+
+uint64_t Trace::Now() { return 0; }
+
+void Trace::Record(const char *, uint64_t, uint64_t) {}
+
+void Trace::SetThreadName(const char *) {}
+
+bool Trace::Flush(const std::string &) { return true; }
+
+#endif // MAZE_ENABLE_TRACING
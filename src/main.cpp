@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "../include/Game.h"
+#include "../include/GLStateCache.h"
 
 // Global Settings
 const unsigned int SCR_WIDTH = 800;
@@ -62,7 +63,7 @@ int main() {
   }
 
   // OpenGL Global settings
-  glEnable(GL_DEPTH_TEST); // Essential for 3D
+  GLStateCache::Get().SetEnabled(GL_DEPTH_TEST, true); // Essential for 3D
 
 
   // initialize game resources (Shaders, Models, Maze)
@@ -109,7 +110,7 @@ int main() {
 // Adjusts the viewport when the window is resized
 
 void framebuffer_size_callback(GLFWwindow *window, int width, int height) {
-  glViewport(0, 0, width, height);
+  GLStateCache::Get().Viewport(0, 0, width, height);
 }
 
 // Captures keys and stores them in the Game state array
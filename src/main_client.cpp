@@ -9,7 +9,11 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 
+#include "../include/FramePacer.h"
 #include "../include/Game.h"
+#include "../include/GLStateCache.h"
+#include "../include/LaunchOptions.h"
+#include "../include/Trace.h"
 
 // Global Settings
 const unsigned int SCR_WIDTH = 800;  ///< Default window width
@@ -59,17 +63,24 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos);
 
 int main(int argc, char *argv[]) {
   // Get host IP from command line argument or use default
-  std::string hostIP = "127.0.0.1";
-  if (argc > 1) {
-    hostIP = argv[1];
-    std::cout << "Using host IP: " << hostIP << std::endl;
+  LaunchOptions options = LaunchOptions::Parse(argc, argv);
+  TRACE_THREAD_NAME("main");
+  if (options.hostIPProvided) {
+    std::cout << "Using host IP: " << options.hostIP << std::endl;
   } else {
-    std::cout << "No host IP provided. Usage: ./maze_client.exe <host_ip>" << std::endl;
-    std::cout << "Using default: " << hostIP << std::endl;
+    std::cout << "No host IP provided. Usage: ./maze_client.exe <host_ip> [--single-thread]" << std::endl;
+    std::cout << "Using default: " << options.hostIP << std::endl;
   }
 
   // Create game instance with the provided host IP
-  MazeGame = new Game(SCR_WIDTH, SCR_HEIGHT, GameMode::CLIENT, hostIP);
+  MazeGame = new Game(SCR_WIDTH, SCR_HEIGHT, GameMode::CLIENT, options.hostIP);
+  if (!MazeGame->ConfigureInputLog(options)) {
+    delete MazeGame;
+    return -1;
+  }
+  MazeGame->sceneBudget = options.sceneBudget;
+  MazeGame->textureBudget = static_cast<size_t>(options.textureBudget) << 20;
+  MazeGame->depthPrepass = options.depthPrepass;
 
   // initialize and set up GLFW
   glfwInit();
@@ -110,7 +121,7 @@ int main(int argc, char *argv[]) {
   }
 
   // OpenGL Global settings
-  glEnable(GL_DEPTH_TEST); // Essential for 3D
+  GLStateCache::Get().SetEnabled(GL_DEPTH_TEST, true); // Essential for 3D
 
 
   // initialize game resources (Shaders, Models, Maze)
@@ -119,34 +130,47 @@ int main(int argc, char *argv[]) {
   // Store window pointer in Game for pause functionality
   MazeGame->windowPtr = window;
 
-  // Main loop
-  while (!glfwWindowShouldClose(window)) {
-    // time management
-    float currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
-
-    // System events (inputs)
-    glfwPollEvents();
+  // Run ticks on their own thread unless --single-thread was given
+  if (options.simulationThread)
+    MazeGame->StartSimulationThread();
 
-    // game logic
-    MazeGame->ProcessInput(deltaTime);
-    MazeGame->Update(deltaTime);
-
-    // rendering
-    // clean color and depth buffer
-    glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Sky blue background
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    MazeGame->Render();
-
-    // swap buffers
-    glfwSwapBuffers(window);
+  // Main loop
+  // (a replay ends the session when its log runs out; the pacer is scoped
+  // so its GL objects are freed while the context is alive)
+  {
+    // Vsync, frame cap and idle throttling of the loop below
+    FramePacer pacer(window, options.vsync, options.fpsCap);
+
+    while (!glfwWindowShouldClose(window) && !MazeGame->ReplayFinished()) {
+      // time management
+      float currentFrame = static_cast<float>(glfwGetTime());
+      deltaTime = currentFrame - lastFrame;
+      lastFrame = currentFrame;
+
+      // System events (inputs); blocks briefly while idle
+      pacer.PollEvents();
+
+      // game logic (fixed ticks, see Game::Advance)
+      float alpha = MazeGame->Advance(deltaTime);
+
+      // rendering (skipped while idle: the cached frame is shown again)
+      if (pacer.BeginFrame(MazeGame->IsIdle())) {
+        // clean color and depth buffer
+        glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Sky blue background
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        MazeGame->Render(alpha);
+      }
+
+      // swap buffers, then wait for the frame cap
+      pacer.EndFrame();
+    }
   }
 
-  // clean
+  // clean (stops the simulation thread first)
   delete MazeGame;
   glfwTerminate();
+  Trace::Flush(options.traceFile);
   return 0;
 }
 
@@ -158,7 +182,7 @@ int main(int argc, char *argv[]) {
 // Adjusts the viewport when the window is resized
 
 void framebuffer_size_callback(GLFWwindow *window, int width, int height) {
-  glViewport(0, 0, width, height);
+  GLStateCache::Get().Viewport(0, 0, width, height);
 }
 
 // Captures keys and stores them in the Game state array
@@ -9,7 +9,12 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 
+#include "../include/Benchmark.h"
+#include "../include/FramePacer.h"
 #include "../include/Game.h"
+#include "../include/GLStateCache.h"
+#include "../include/LaunchOptions.h"
+#include "../include/Trace.h"
 
 // Global Settings
 const unsigned int SCR_WIDTH = 800;  ///< Default window width
@@ -60,13 +65,20 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos);
 int main(int argc, char *argv[]) {
   // Create game instance in HOST mode
   // Optional IP argument can be passed (for future use if needed)
-  std::string hostIP = "127.0.0.1";
-  if (argc > 1) {
-    hostIP = argv[1];
-    std::cout << "Host IP provided: " << hostIP << std::endl;
+  LaunchOptions options = LaunchOptions::Parse(argc, argv);
+  TRACE_THREAD_NAME("main");
+  if (options.hostIPProvided) {
+    std::cout << "Host IP provided: " << options.hostIP << std::endl;
   }
 
-  MazeGame = new Game(SCR_WIDTH, SCR_HEIGHT, GameMode::HOST, hostIP);
+  MazeGame = new Game(SCR_WIDTH, SCR_HEIGHT, GameMode::HOST, options.hostIP);
+  if (!MazeGame->ConfigureInputLog(options)) {
+    delete MazeGame;
+    return -1;
+  }
+  MazeGame->sceneBudget = options.sceneBudget;
+  MazeGame->textureBudget = static_cast<size_t>(options.textureBudget) << 20;
+  MazeGame->depthPrepass = options.depthPrepass;
 
   // initialize and set up GLFW
   glfwInit();
@@ -78,6 +90,13 @@ int main(int argc, char *argv[]) {
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // Fix for MacOS
 #endif
 
+  // Headless benchmark: never show the window, render to an FBO instead
+  if (options.headless) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (options.egl)
+      glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+  }
+
   // create window
   GLFWwindow *window =
       glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Maze HOST", NULL, NULL);
@@ -107,7 +126,7 @@ int main(int argc, char *argv[]) {
   }
 
   // OpenGL Global settings
-  glEnable(GL_DEPTH_TEST); // Essential for 3D
+  GLStateCache::Get().SetEnabled(GL_DEPTH_TEST, true); // Essential for 3D
 
 
   // initialize game resources (Shaders, Models, Maze)
@@ -116,34 +135,56 @@ int main(int argc, char *argv[]) {
   // Store window pointer in Game for pause functionality
   MazeGame->windowPtr = window;
 
-  // Main loop
-  while (!glfwWindowShouldClose(window)) {
-    // time management
-    float currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
-
-    // System events (inputs)
-    glfwPollEvents();
-
-    // game logic
-    MazeGame->ProcessInput(deltaTime);
-    MazeGame->Update(deltaTime);
-
-    // rendering
-    // clean color and depth buffer
-    glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Sky blue background
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  // Headless: fixed number of offscreen frames, then exit
+  if (options.headless) {
+    int status = Benchmark::Run(*MazeGame, options);
+    delete MazeGame;
+    glfwTerminate();
+    Trace::Flush(options.traceFile);
+    return status;
+  }
 
-    MazeGame->Render();
+  // Run ticks on their own thread unless --single-thread was given
+  if (options.simulationThread)
+    MazeGame->StartSimulationThread();
 
-    // swap buffers
-    glfwSwapBuffers(window);
+  // Main loop
+  // (a replay ends the session when its log runs out; the pacer is scoped
+  // so its GL objects are freed while the context is alive)
+  {
+    // Vsync, frame cap and idle throttling of the loop below
+    FramePacer pacer(window, options.vsync, options.fpsCap);
+
+    while (!glfwWindowShouldClose(window) && !MazeGame->ReplayFinished()) {
+      // time management
+      float currentFrame = static_cast<float>(glfwGetTime());
+      deltaTime = currentFrame - lastFrame;
+      lastFrame = currentFrame;
+
+      // System events (inputs); blocks briefly while idle
+      pacer.PollEvents();
+
+      // game logic (fixed ticks, see Game::Advance)
+      float alpha = MazeGame->Advance(deltaTime);
+
+      // rendering (skipped while idle: the cached frame is shown again)
+      if (pacer.BeginFrame(MazeGame->IsIdle())) {
+        // clean color and depth buffer
+        glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Sky blue background
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        MazeGame->Render(alpha);
+      }
+
+      // swap buffers, then wait for the frame cap
+      pacer.EndFrame();
+    }
   }
 
-  // clean
+  // clean (stops the simulation thread first)
   delete MazeGame;
   glfwTerminate();
+  Trace::Flush(options.traceFile);
   return 0;
 }
 
@@ -155,7 +196,7 @@ int main(int argc, char *argv[]) {
 // Adjusts the viewport when the window is resized
 
 void framebuffer_size_callback(GLFWwindow *window, int width, int height) {
-  glViewport(0, 0, width, height);
+  GLStateCache::Get().Viewport(0, 0, width, height);
 }
 
 // Captures keys and stores them in the Game state array
@@ -6,6 +6,7 @@
  */
 
 #include "../include/Network.h"
+#include "../include/Trace.h"
 #include <arpa/inet.h>
 #include <cerrno>
 #include <cstring>
@@ -20,6 +21,7 @@ using namespace std;
  * @return Socket descriptor or -1 on error
  */
 int Network::createSocket() {
+  TRACE_SCOPE("Network::createSocket");
   int sock = socket(AF_INET, SOCK_STREAM, 0);
   if (sock < 0) {
     cerr << "Error creating socket: " << strerror(errno) << endl;
@@ -34,6 +36,7 @@ int Network::createSocket() {
  * @return true on success, false on error
  */
 bool Network::bindAndListen(int socket, int port) {
+  TRACE_SCOPE("Network::bindAndListen");
   // Allow port reuse
   int opt = 1;
   setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
@@ -63,6 +66,7 @@ bool Network::bindAndListen(int socket, int port) {
  * @return Client socket descriptor or -1 on error
  */
 int Network::acceptConnection(int serverSocket) {
+  TRACE_SCOPE("Network::acceptConnection");
   int clientSocket = accept(serverSocket, nullptr, nullptr);
   if (clientSocket < 0) {
     cerr << "Error accepting connection: " << strerror(errno) << endl;
@@ -78,6 +82,7 @@ int Network::acceptConnection(int serverSocket) {
  * @return true on success, false on error
  */
 bool Network::connectToServer(int socket, const string &ip, int port) {
+  TRACE_SCOPE("Network::connectToServer");
   sockaddr_in serverAddress;
   serverAddress.sin_family = AF_INET;
   serverAddress.sin_port = htons(port);
@@ -104,6 +109,7 @@ bool Network::connectToServer(int socket, const string &ip, int port) {
  * @return true on success, false on error
  */
 bool Network::sendData(int socket, const void *data, size_t size) {
+  TRACE_SCOPE("Network::sendData");
   ssize_t bytesSent = send(socket, data, size, 0);
   if (bytesSent < 0) {
     cerr << "Error sending data: " << strerror(errno) << endl;
@@ -120,6 +126,7 @@ bool Network::sendData(int socket, const void *data, size_t size) {
  * @return Number of bytes received
  */
 ssize_t Network::receiveData(int socket, void *buffer, size_t size) {
+  TRACE_SCOPE("Network::receiveData");
   return recv(socket, buffer, size, 0);
 }
 